@@ -0,0 +1,17 @@
+# Fails the build when a generated artifact exceeds its size budget
+# Usage: cmake -DFILE=<path> -DBUDGET=<bytes> -P check_size.cmake
+
+if(NOT EXISTS "${FILE}")
+    message(FATAL_ERROR "Size check: ${FILE} does not exist")
+endif()
+
+# file(SIZE) needs CMake 3.14; reading as hex works on 3.10
+file(READ "${FILE}" contents HEX)
+string(LENGTH "${contents}" hex_length)
+math(EXPR size "${hex_length} / 2")
+
+get_filename_component(name "${FILE}" NAME)
+if(size GREATER BUDGET)
+    message(FATAL_ERROR "Size budget exceeded: ${name} is ${size} bytes (budget ${BUDGET})")
+endif()
+message(STATUS "Size budget: ${name} is ${size} bytes (budget ${BUDGET})")
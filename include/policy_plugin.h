@@ -0,0 +1,40 @@
+#ifndef POLICY_PLUGIN_H
+#define POLICY_PLUGIN_H
+
+#include <memory>
+#include <string>
+
+#include "scheduler_policy.h"
+
+/**
+ * One created policy (see include/scheduler_policy.h)
+ * Destroys the plug-in state and, for loaded plug-ins, keeps the shared object
+ * mapped for as long as any Scheduler uses the policy
+ */
+struct PolicyInstance {
+    sched_policy table = sched_policy();
+    std::shared_ptr<void> library;   // dlopen / LoadLibrary handle, null if linked in
+
+    PolicyInstance() = default;
+    PolicyInstance(const PolicyInstance&) = delete;
+    PolicyInstance& operator=(const PolicyInstance&) = delete;
+    ~PolicyInstance() {
+        if (table.destroy) table.destroy(table.state);
+    }
+
+    bool wants(uint32_t hook) const { return (table.hooks & hook) != 0; }
+};
+
+/**
+ * Create a policy from an entry point linked into the program
+ * Returns null and sets 'error' if the plug-in fails or declares a hook it lacks
+ */
+std::shared_ptr<PolicyInstance> createPolicy(sched_policy_entry entry, std::string& error);
+
+/**
+ * Load a plug-in shared object and create a policy from its SCHED_POLICY_ENTRY
+ * Not available in WebAssembly builds
+ */
+std::shared_ptr<PolicyInstance> loadPolicy(const std::string& path, std::string& error);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef PRIORITY_EXPR_H
+#define PRIORITY_EXPR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Priority expression for the "Expr" / "ExprP" algorithms
+ * A formula over process fields; the ready process with the lowest score runs
+ * (ties: earlier arrival, then lower id)
+ *
+ *   priority * 2 + remaining / burst - age
+ *
+ * Fields (times in user units):
+ *   id, priority, arrival, burst, remaining, executed (burst - remaining),
+ *   waiting, age (now - arrival), now
+ * Operators: + - * / (unary -), parentheses, min(a, b), max(a, b), abs(a)
+ *
+ * Compiled once into flat postfix bytecode with constant subexpressions folded
+ */
+class PriorityExpr {
+public:
+    enum Field : uint8_t { ID, PRIORITY, ARRIVAL, BURST, REMAINING, EXECUTED, WAITING, AGE, NOW, FIELD_COUNT };
+    static const int MAX_DEPTH = 64;   // Evaluation stack limit
+
+    // Returns false and sets 'error' ("column N: ...") without changing this expression
+    bool compile(const std::string& text, std::string& error);
+
+    bool empty() const { return code.empty(); }
+    const std::string& text() const { return source; }
+    bool uses(Field field) const { return (fieldMask >> field) & 1u; }
+
+    // A waiting process's score only changes when its priority does
+    // (no waiting / age / now), so scores can be cached while it waits
+    bool isTimeInvariant() const { return !uses(WAITING) && !uses(AGE) && !uses(NOW); }
+
+    // 'fields' is indexed by Field; an empty expression scores 0
+    double evaluate(const double* fields) const;
+
+private:
+    enum OpCode : uint8_t { CONST, LOAD, ADD, SUB, MUL, DIV, NEG, MIN, MAX, ABS };
+    struct Op {
+        OpCode code;
+        uint8_t field;
+        double value;
+    };
+
+    std::vector<Op> code;
+    uint32_t fieldMask = 0;
+    std::string source;
+
+    friend class ExprParser;
+};
+
+#endif
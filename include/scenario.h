@@ -0,0 +1,87 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <string>
+#include <vector>
+
+#include "scheduler.h"
+#include "sweep.h"
+
+/**
+ * Scenario files: a run configuration plus its workload
+ *
+ * Text form (JSON Lines, one object per line; blank lines and '#' comments skipped):
+ *   {"format": "scheduler-scenario", "version": 1, "config": {"algorithm": "RR", "quantum": 2,
+ *    "aging": false, "aging_threshold": 5, "aging_boost": 1, "time_resolution": 1,
+ *    "context_switch": 0}}
+ *   {"id": 1, "name": "P1", "arrival": 0, "burst": 5, "priority": 0}
+ *   {"parent": 1, "child": 2}          (version 2: workflow dependency)
+ *
+ * Binary form (little-endian): "PSCN", u32 version, config, u32 count, then per
+ * process i32 id, f64 arrival, f64 burst, i32 priority, u16 name length, name bytes;
+ * version 2 appends u32 edge count, then per edge i32 parent, i32 child
+ *
+ * Scenarios without dependencies are written as version 1, so older readers
+ * still accept them
+ */
+
+const int SCENARIO_VERSION = 2;
+const size_t SCENARIO_MAX_ERRORS = 1000;  // Further errors are summarized in one entry
+
+struct Scenario {
+    int version = SCENARIO_VERSION;
+    SweepJob config;
+    SimTime timeResolution = 1;
+    double contextSwitchCost = 0;
+    std::vector<ProcessSpec> processes;
+    std::vector<DependencySpec> dependencies;  // Each parent is listed before its child
+};
+
+/**
+ * One validation problem; 'line' is the text line (or binary record) number,
+ * 0 when it concerns the file as a whole
+ */
+struct ScenarioError {
+    int line;
+    std::string message;
+};
+
+/**
+ * Parse and validate; returns false if any error was found ('out' then holds
+ * whatever parsed cleanly). Every error is reported, not just the first
+ */
+bool parseScenario(const std::string& text, Scenario& out, std::vector<ScenarioError>& errors);
+bool parseScenarioBinary(const std::string& bytes, Scenario& out, std::vector<ScenarioError>& errors);
+
+/**
+ * Read a file in either form (detected by the binary magic)
+ */
+bool loadScenarioFile(const std::string& path, Scenario& out, std::vector<ScenarioError>& errors);
+
+std::string formatScenario(const Scenario& scenario);
+std::string formatScenarioBinary(const Scenario& scenario);
+
+/**
+ * Algorithms a scenario (or the C ABI) may select
+ */
+bool isKnownAlgorithm(const std::string& algorithm);
+
+/**
+ * Whether 'value' time units at 'timeResolution' base units per unit round to a
+ * representable SimTime (what Scheduler::toBase computes)
+ */
+bool fitsSimTime(double value, SimTime timeResolution);
+
+/**
+ * Configure 'scheduler' and add every process and dependency
+ */
+void applyScenario(const Scenario& scenario, Scheduler& scheduler);
+
+/**
+ * JSON front end used by the WASM bindings
+ * {"ok", "errors": [{line, message}], "config": {...}, "processes": [{id, name, arrival, burst, priority}],
+ *  "dependencies": [{parent, child}]}
+ */
+nlohmann::json parseScenarioJSON(const std::string& text);
+
+#endif
@@ -1,10 +1,43 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "priority_expr.h"
+#include "scheduler_policy.h"
+
+// Define SCHEDULER_NO_JSON for size-optimized builds that read state through
+// getStateFrame()/syncProcessTable() instead of JSON
+#ifndef SCHEDULER_NO_JSON
 #include "json.hpp"
+#endif
+
+/**
+ * Simulation time in fixed-point base units
+ * One engine tick advances one base unit; Scheduler::setTimeResolution() sets how
+ * many base units make up one user-facing time unit (1 = classic integer ticks)
+ */
+typedef int64_t SimTime;
+
+struct PolicyInstance;  // include/policy_plugin.h
+
+/**
+ * Simulated mutex usage within a process burst
+ * Offsets are measured in executed time units (burstTime - remainingTime)
+ * A process may take the same lock several times, in disjoint intervals
+ */
+struct LockRequest {
+    int lockId;
+    SimTime acquireAt;   // Lock is taken before executing this offset
+    SimTime releaseAt;   // Lock is dropped after executing up to this offset
+};
 
 /**
  * Process Control Block (PCB) structure
@@ -13,26 +46,200 @@
 struct Process {
     int id;
     std::string name;
-    int arrivalTime;
-    int burstTime;
+    SimTime arrivalTime;
+    SimTime burstTime;
     int priority;  // Lower value = Higher priority
     
     // Runtime tracking
-    int remainingTime;
-    int startTime = -1;         // -1 indicates process hasn't started
-    int completionTime = -1;
-    int waitingTime = 0;
-    int turnaroundTime = 0;
-    int responseTime = -1;      // Time from arrival to first execution
+    SimTime remainingTime;
+    SimTime startTime = -1;         // -1 indicates process hasn't started
+    SimTime completionTime = -1;
+    SimTime waitingTime = 0;
+    SimTime turnaroundTime = 0;
+    SimTime responseTime = -1;      // Time from arrival to first execution
     
     // Aging support
-    int ageCounter = 0;
+    SimTime ageCounter = 0;
     int originalPriority;       // Track original priority for aging
+    
+    // Multilevel queue support
+    int queueClass = 0;         // Index into Scheduler queue classes (0 = highest)
+    
+    // Resource lock support
+    std::vector<LockRequest> lockRequests;
+    std::vector<int> heldRequests;   // Indices into lockRequests currently held
+    int blockedOn = -1;         // Lock id this process waits on, -1 if runnable
+    int basePriority = -1;      // Priority before inheritance/ceiling boost, -1 if not boosted
+    SimTime blockedTime = 0;        // Ticks spent waiting on locks
+    SimTime inversionTime = 0;      // Ticks blocked while a lower-priority process ran
+    
+    // Gang scheduling support
+    int threadCount = 1;        // Threads that must run together on distinct cores
+    std::vector<int> assignedCores;
+    
+    // DVFS support: outstanding work in cycles (MHz x ticks), -1 until first DVFS execution
+    long long remainingCycles = -1;
+    SimTime cpuTime = 0;        // Ticks spent executing; differs from burstTime under DVFS
+    
+    // Priority expression support: last computed score ("Expr" / "ExprP")
+    double score = 0;
+    
+    // Non-clairvoyant mode: burst predicted at arrival, -1 when SJF / SRTF see the true burst
+    SimTime predictedBurst = -1;
+    
+    int slot = -1;              // Row in the ProcessTable (addProcess order)
+};
+
+/**
+ * Core operating point for the DVFS model
+ */
+struct FrequencyState {
+    int mhz;
+    double voltage;
+};
+
+/**
+ * Simulated mutex with its wait queue
+ * Waiters are parked here (not in any ready queue) until ownership is handed to them
+ */
+struct SimLock {
+    int owner = -1;             // Holding process id, -1 if free
+    int ceiling = 0x7fffffff;   // Highest priority (lowest value) of any declared user
+    std::vector<Process> waiters;
+};
+
+/**
+ * Ready queue class for the multilevel queue (MLQ) policy
+ * Each class runs one of the existing algorithms over its own ready queue
+ */
+struct QueueClass {
+    std::string algorithm = "FCFS";
+    double quantumUnits = 2;    // As configured, in time units
+    double sliceUnits = 1;
+    SimTime timeQuantum = 2;    // Used when algorithm is RR (base units)
+    SimTime timeSlice = 1;      // Ticks per turn under the TimeSlice inter-queue policy
+    std::vector<Process> readyQueue;
+};
+
+/**
+ * Finished bursts of one process name, for burst prediction
+ */
+struct BurstHistory {
+    static const size_t WINDOW = 16;
+    double average = 0;          // Exponential average (base units)
+    std::vector<SimTime> recent; // Last WINDOW bursts, a ring once full
+    size_t count = 0;            // Bursts seen
+};
+
+/**
+ * Dependency bookkeeping of one process (see Scheduler::addDependency)
+ */
+struct DagNode {
+    std::vector<int32_t> children;  // Child slots
+    int32_t pendingParents = 0;     // Unfinished parents; the process is held while > 0
+    SimTime arrival = 0;            // Arrival as added, before any release (base units)
+    SimTime burst = 0;
+    SimTime releaseTime = 0;        // Latest parent completion so far
+};
+
+/**
+ * Critical-path analysis of the dependency DAG (see Scheduler::getDagMetrics)
+ * Earliest times assume unlimited CPUs: a process can start at its arrival or
+ * when its last parent completes, whichever is later. Times in user units
+ */
+struct DagMetrics {
+    double criticalPath = 0;       // Latest earliest finish: no schedule completes sooner
+    double work = 0;               // Sum of bursts: no single-CPU schedule completes sooner
+    double makespan = 0;           // Latest completion so far, final once isFinished()
+    int held = 0;                  // Processes still waiting on a parent
+    std::vector<double> slack;     // Per row (addProcess order): latest minus earliest start
+    std::vector<int> criticalIds;  // Processes with zero slack, addProcess order
+};
+
+/**
+ * Compact per-tick snapshot for publishing state without JSON
+ * Times are in user-facing time units; ids are -1 when absent
+ */
+struct StateFrame {
+    double time;
+    int lastExecutedId;
+    int cpuId;
+    double cpuRemaining;
+    int readyCount;
+    int finishedCount;
+};
+
+/**
+ * Retained tick log line as returned by Scheduler::getLog (see setLogCapacity)
+ */
+struct LogEntry {
+    SimTime time;              // Base units, start of the tick
+    std::string text;
+};
+
+/**
+ * Keys of one process as seen by a scheduling decision
+ */
+struct DecisionCandidate {
+    int id;
+    SimTime burst;
+    SimTime remaining;
+    int priority;
+    SimTime arrival;
+};
+
+/**
+ * Structured explanation of one dispatch or preemption (see Scheduler::setExplainCapacity)
+ * Candidates are listed in the order the policy ranked them, truncated to TOP_K
+ */
+struct DecisionRecord {
+    enum Kind { DISPATCH, PREEMPT, QUANTUM_EXPIRED, CLASS_PREEMPT };
+    static const int TOP_K = 4;
+    
+    SimTime time = 0;
+    Kind kind = DISPATCH;
+    const char* rule = "";    // Algorithm that made the decision (static storage, never freed)
+    int chosenId = -1;         // Dispatched or preempting process, -1 if none
+    int preemptedId = -1;      // Process taken off the CPU, -1 if none
+    int candidateTotal = 0;    // Candidates considered, including truncated ones
+    int candidateCount = 0;    // Entries filled in 'candidates'
+    DecisionCandidate candidates[TOP_K];
+};
+
+/**
+ * Outcome of a wall-clock budgeted run (see Scheduler::runFor)
+ */
+struct RunSummary {
+    int ticks = 0;             // Ticks executed
+    double time = 0;           // Simulation time reached, in time units
+    bool finished = false;
+    double elapsedMs = 0;      // Wall-clock time spent
+    std::string log;           // Tick logs, one per line
+};
+
+/**
+ * Per-process columns exposed to JS as typed-array views (row = addProcess order)
+ * Times are in user-facing time units; waiting/turnaround/response are final once FINISHED
+ */
+struct ProcessTable {
+    enum : int32_t { NOT_ARRIVED = 0, READY = 1, RUNNING = 2, FINISHED = 3, BLOCKED = 4 };
+    
+    std::vector<int32_t> ids;
+    std::vector<int32_t> state;
+    std::vector<double> remaining;
+    std::vector<int32_t> priority;
+    std::vector<double> waiting;
+    std::vector<double> turnaround;
+    std::vector<double> response;
+    std::vector<int32_t> readyOrder;  // Position across the ready queue(s), -1 otherwise
 };
 
 /**
  * CPU Scheduler Implementation
- * Supports: FCFS, SJF, SRTF, RR, Priority (Preemptive & Non-Preemptive)
+ * Supports: FCFS, SJF, SRTF, RR, Priority (Preemptive & Non-Preemptive),
+ *           HRRN (highest response ratio next, Preemptive & Non-Preemptive),
+ *           MLQ (multilevel queue composed of the above),
+ *           Gang (co-scheduling of multi-threaded processes on simulated cores)
  * Optional: Aging mechanism to prevent starvation
  */
 class Scheduler {
@@ -40,42 +247,286 @@ public:
     Scheduler();
 
     // Configuration methods
-    void addProcess(int id, std::string name, int arrivalTime, int burstTime, int priority);
+    // Times are in user units. Settings (quantum, aging threshold, context switch,
+    // queue classes, initial burst guess) follow later resolution changes; process
+    // times and lock offsets are converted once, so add them after setTimeResolution()
+    void setTimeResolution(SimTime unitsPerTime);  // Base units per time unit (default 1)
+    void setContextSwitchCost(double cost);        // CPU time lost when switching processes
+    // Returns false (and adds nothing) for a negative or already used id
+    bool addProcess(int id, std::string name, double arrivalTime, double burstTime, int priority);
     void setAlgorithm(std::string algo); 
-    void setTimeQuantum(int q);
+    void setTimeQuantum(double q);
     void setAging(bool enabled);
-    void setAgingThreshold(int threshold);   // How many ticks before boost
-    void setAgingBoostAmount(int amount);    // How much to boost priority
+    void setAgingThreshold(double threshold);   // How long before boost
+    void setAgingBoostAmount(int amount);       // How much to boost priority
+    
+    // Multilevel queue configuration (algorithm "MLQ")
+    // Until the first addQueueClass(), MLQ runs a single default FCFS class
+    int addQueueClass(std::string algo, double quantum, double timeSlice);  // Returns class index
+    void setInterQueuePolicy(std::string policy);  // "Strict" or "TimeSlice"
+    void setProcessClass(int id, int queueClass);
+    
+    // Resource locks
+    void addLockRequest(int processId, int lockId, double acquireAt, double releaseAt);
+    void setLockProtocol(std::string protocol);  // "None", "Inheritance" or "Ceiling"
+    
+    // Gang scheduling (algorithm "Gang", slot length = time quantum)
+    void setCoreCount(int cores);
+    void setProcessThreads(int id, int threads);
+    
+    // Workflow DAG: 'childId' arrives only once 'parentId' (and every other parent)
+    // has finished, at its own arrival time or the last parent's completion,
+    // whichever is later; waiting and turnaround then count from that release.
+    // Returns false (and adds nothing) unless both ids exist, the parent was added
+    // before the child (so addProcess order is topological and cycles can't form)
+    // and the child has not arrived yet
+    bool addDependency(int parentId, int childId);
+    DagMetrics getDagMetrics() const;   // O(processes + edges)
+    
+    // Energy / DVFS model (bursts are measured at the reference frequency)
+    void setDVFS(bool enabled);
+    void addFrequencyState(int mhz, double voltage);
+    void setGovernor(std::string governor);  // "performance", "powersave" or "ondemand"
+    void setPowerModel(double staticWatts, double capacitance);  // P = static + C * V^2 * MHz
+    void setReferenceFrequency(int mhz);
+    
+    // Non-clairvoyant SJF / SRTF: order by a burst predicted at arrival instead of
+    // the true one, which still drives execution. Predictors: "None" (default, true
+    // bursts), "EWMA" (exponential average, 'param' = weight of the newest burst) or
+    // "Quantile" ('param' quantile of the last 16 bursts), over finished processes
+    // with the same name, or over all finished processes for a name not seen yet
+    void setBurstPredictor(std::string predictor, double param);
+    void setInitialBurstGuess(double guess);   // Prediction before anything finished (default 1)
+    
+    // Priority expression for "Expr" (non-preemptive) and "ExprP" (preemptive),
+    // see include/priority_expr.h. Returns "" or the compile error (expression unchanged)
+    std::string setPriorityExpression(const std::string& text);
+    
+    // Plug-in policy: switches to algorithm "Plugin" (null switches back to FCFS)
+    // Copies of a Scheduler share the policy instance and its state
+    void setPolicy(std::shared_ptr<PolicyInstance> policy);
     
     // Simulation control
-    std::string tick();  // Execute one time unit
+    std::string tick();  // Execute one base time unit
+    RunSummary runFor(double budgetMs, int maxTicks = 0);  // Ticks until budget spent, 0 = no tick cap
     bool isFinished() const;
     
     // State inspection
+#ifndef SCHEDULER_NO_JSON
     nlohmann::json getStateJSON() const;
+    nlohmann::json getFinishedJSON(size_t offset, size_t count, const std::string& sortBy);
+    nlohmann::json getLogJSON(double fromTime, size_t count) const;
+    nlohmann::json getDecisionsJSON(double fromTime, size_t count) const;
+    nlohmann::json getProcessJSON(int id) const;  // null if unknown
+#endif
+    StateFrame getStateFrame() const;
+    const std::vector<Process>& getFinishedProcesses() const;
+    
+    // Process lookup (O(1) through the id -> slot index)
+    const Process* getProcess(int id) const;   // nullptr if unknown
+    std::vector<int> getProcessIdsByName(const std::string& name) const;  // addProcess order
+    
+    // Paged history for large runs
+    void setLogCapacity(size_t entries);      // Tick logs kept in a ring, 0 = none (default)
+    std::vector<LogEntry> getLog(double fromTime, size_t count) const;  // Oldest first
+    size_t getFinishedCount() const;
+    // sortBy: "" (finish order), "id", "arrival", "burst", "priority", "completion",
+    // "waiting", "turnaround" or "response"; prefix with '-' for descending
+    std::vector<Process> getFinished(size_t offset, size_t count, const std::string& sortBy);
+    
+    // Decision explanations (compiled out with SCHEDULER_NO_EXPLAIN)
+    void setExplainCapacity(size_t records);  // Preallocated ring size, 0 = off (default)
+    std::vector<DecisionRecord> getDecisions(double fromTime, size_t count) const;  // Oldest first
+    
+    // Zero-copy state: buffers may move whenever the version changes
+    uint32_t getStateVersion() const;        // Bumped by tick() and addProcess()
+    const ProcessTable& syncProcessTable();  // Refreshes rows that can have changed since the last call
+    void setRecordTimeline(bool enabled);    // Keep lastExecutedId of every tick
+    void setTimelineCapacity(size_t ticks);  // Newest ticks kept (default 1M); drops the oldest half when full
+    const std::vector<int32_t>& getTimeline() const;
+    size_t getTimelineStart() const;         // Tick of getTimeline()[0] (ticks dropped so far)
+    
+    // Determinism checks: running hash of the inputs and of every tick's events
+    // (arrivals, executions, aging/lock priority changes, completions)
+    // Integer-only, so native and WASM builds agree tick for tick
+    uint64_t getStateHash() const;
+    
+    SimTime getCurrentTime() const;         // In base units
+    SimTime getTimeResolution() const;
 
 private:
     // Configuration
     std::string algorithm = "FCFS";
     bool agingEnabled = false;
-    int timeQuantum = 2;
-    int agingThreshold = 5;  // Increase priority after this many ticks
-    int currentTime = 0;
+    SimTime timeQuantum = 2;
+    SimTime agingThreshold = 5;  // Increase priority after this many ticks
+    SimTime currentTime = 0;
+    SimTime timeResolution = 1;  // Base units per user-facing time unit
+    SimTime contextSwitchCost = 0;
+    SimTime switchRemaining = 0; // Switch overhead left before the CPU process runs
+    // Time-valued settings as configured, in time units; setTimeResolution()
+    // rederives the base-unit copies from these
+    double quantumUnits = 2;
+    double agingThresholdUnits = 5;
+    double contextSwitchUnits = 0;
+    double initialGuessUnits = 1;
+    int lastDispatchedId = -1;
     
     // Process queues
-    std::vector<Process> jobPool;           // Processes not yet arrived
+    std::vector<Process> jobPool;           // Processes not yet arrived, in no particular order
+    // Min-heap of (due, slot) over jobPool: due = max(arrival, time added) is the tick the
+    // process arrives at, and slots order same-tick arrivals as addProcess did. Entries
+    // of processes that have left jobPool are skipped when they come up
+    std::vector<std::pair<SimTime, int32_t>> arrivalHeap;
     std::vector<Process> readyQueue;        // Processes ready to execute
     std::vector<Process> finishedProcesses; // Completed processes
     
     // CPU state (vector of size 0 or 1 for safe access)
     std::vector<Process> cpu; 
-    int currentQuantumUsed = 0;
+    SimTime currentQuantumUsed = 0;
     int agingBoostAmount = 1;    // How much to decrease priority value per boost
     
+    // Multilevel queue state
+    std::vector<QueueClass> queueClasses;
+    std::string interQueuePolicy = "Strict";
+    bool implicitClass = false;  // queueClasses[0] is the default added by setAlgorithm("MLQ")
+    int activeClass = 0;         // Class currently served (TimeSlice policy)
+    SimTime classSliceUsed = 0;  // Ticks consumed by activeClass in its slice
+    
+    // Resource lock state (ordered maps keep runs deterministic)
+    std::map<int, SimLock> locks;
+    std::set<int> contendedLocks;  // Locks with at least one waiter
+    std::string lockProtocol = "None";
+    int blockedCount = 0;
+    bool deadlocked = false;
+    long long inversionTicks = 0;           // Sum over blocked processes
+    long long unboundedInversionTicks = 0;  // Inversions where the runner isn't the lock holder
+    
+    // Gang scheduling state
+    int coreCount = 1;
+    std::vector<uint64_t> freeCoreMask;     // Bit set = core free, 64 cores per word
+    int freeCoreCount = 1;
+    std::vector<int> coreOwner;             // Process id per core, -1 if idle
+    std::vector<Process> gangRunning;       // Gangs dispatched in the current slot
+    SimTime gangSlotUsed = 0;
+    long long busyCoreTicks = 0;
+    long long idleCoreTicks = 0;
+    long long fragmentedCoreTicks = 0;      // Idle while a ready gang could not fit
+    
+    // Energy / DVFS state
+    bool dvfsEnabled = false;
+    std::vector<FrequencyState> frequencyStates;  // Ascending by MHz
+    std::string governor = "performance";
+    double staticPower = 0.5;          // Watts per core
+    double capacitance = 0.0005;       // Watts per (V^2 * MHz) while busy
+    int referenceMHz = 0;              // 0 = fastest state
+    std::vector<int> coreFreqLevel;    // Index into frequencyStates per core
+    std::vector<char> coreWasBusy;     // Load seen by the ondemand governor
+    double staticEnergy = 0.0;         // Watt-ticks, divided by timeResolution when reported
+    double dynamicEnergy = 0.0;
+    long long frequencyTicks = 0;      // Sum of MHz over busy core-ticks
+    long long dvfsBusyTicks = 0;
+    
+    // Priority expression state
+    PriorityExpr priorityExpr;
+    // Time-invariant expressions keep readyQueue[0, exprHeapSize) a min-heap on
+    // (score, arrival, id); arrivals and preemptions extend the tail and are
+    // pushed in at the next decision, priority changes reset it to 0
+    size_t exprHeapSize = 0;
+    
+    // Response-ratio state ("HRRN" / "HRRNP")
+    // readyQueue[0, ratioHeapSize) is a kinetic max-heap on (waiting + remaining) / remaining.
+    // Waiting processes' ratios grow at different rates, so every heap edge carries a
+    // certificate: the waitClock at which the child overtakes its parent. The heap is
+    // only repaired where certificates fail, never re-scanned
+    SimTime waitClock = 0;             // updateWaitingTimes() calls so far
+    size_t ratioHeapSize = 0;
+    std::vector<SimTime> ratioCert;    // Per heap position, INT64_MAX when it can't fail
+    std::vector<std::pair<SimTime, uint32_t>> ratioEvents;  // Min-heap of (cert, position), stale entries skipped
+    
+    // Plug-in policy state
+    std::shared_ptr<PolicyInstance> policy;
+    std::string policyRule;                          // "plugin:<name>", the decision rule
+    const char* policyRuleName = nullptr;            // policyRule interned, once recorded
+    std::vector<sched_policy_process> policyReady;   // View staging (reused across ticks)
+    sched_policy_process policyRunning;
+    sched_policy_view policyView;
+    
+    // Burst prediction state
+    std::string burstPredictor = "None";
+    double predictorParam = 0.5;
+    SimTime initialBurstGuess = 1;
+    std::unordered_map<std::string, BurstHistory> burstHistory;  // Per process name
+    BurstHistory allBursts;                // Fallback for names with no history
+    double predictionAbsError = 0;         // Sums over finished predicted processes (base units)
+    double predictionRelError = 0;
+    size_t predictedCount = 0;
+    
+    // Workflow DAG state (empty until the first addDependency)
+    // Processes with unfinished parents wait in heldProcesses, outside jobPool; a
+    // completion decrements its children's pendingParents and a child reaching 0
+    // is released without any rescan
+    std::vector<DagNode> dagNodes;         // Per slot
+    std::vector<Process> heldProcesses;    // Positions kept in slotPos as they change
+    std::vector<int32_t> releasedSlots;    // Released at the last completion, arrive next tick
+    bool dagChanged = false;               // jobPool may hold processes with pending parents
+    
     // Track what executed this tick (for Gantt)
     int lastExecutedId = -1;
     std::string lastExecutedName = ""; 
     
+    // Zero-copy table state
+    uint32_t stateVersion = 0;
+    uint32_t tableVersion = 0;   // stateVersion the table was last built at
+    bool tableStale = true;      // Every row needs rewriting (processes, units or DAG changed)
+    size_t tableFinished = 0;    // Finished processes already written to the table
+    ProcessTable table;
+    bool recordTimeline = false;
+    std::vector<int32_t> timeline;  // lastExecutedId per tick, from tick timelineStart
+    size_t timelineCapacity = size_t(1) << 20;
+    size_t timelineStart = 0;
+    
+    // State hash (see getStateHash)
+    uint64_t stateHash = 0;
+    size_t hashedFinished = 0;   // Finished processes already folded in
+    void hashEvent(int64_t value);
+    
+    // Lookup index: id -> slot, and per slot the container it is in and its exact
+    // position there. Both are updated wherever a process moves, and positions
+    // wherever a container is sorted, erased from or heap-swapped
+    std::unordered_map<int, int> slotOfId;
+    std::vector<uint8_t> slotWhere;      // ProcessTable state code
+    std::vector<int32_t> slotContainer;  // Ready class (-1 = main queue), lock id, -2 = gang, -3 = held
+    std::vector<uint32_t> slotPos;
+    std::unordered_map<std::string, int> nameIds;  // Interned names
+    std::vector<std::vector<int>> idsByName;       // Ids per interned name
+    
+    // Paged history state: fixed-size records into one text arena, so retaining
+    // a tick log appends bytes instead of allocating a string per tick
+    struct LogRecord {
+        SimTime time;
+        size_t offset;              // Absolute byte offset (logTextBase + index into logText)
+        uint32_t length;
+    };
+    size_t logCapacity = 0;
+    std::vector<LogRecord> logRing;
+    size_t logStart = 0;            // Ring index of the oldest entry once full
+    std::string logText;            // Retained text, after a dropped prefix not yet compacted
+    size_t logTextBase = 0;         // Absolute offset of logText[0]
+    std::map<std::string, std::vector<uint32_t>> finishedOrder;  // Sorted finished indices per key
+    
+    // Decision ring (allocated once by setExplainCapacity)
+    std::vector<DecisionRecord> decisionRing;
+    size_t decisionStart = 0;       // Ring index of the oldest record
+    size_t decisionCount = 0;
+    
+    // Time base helpers
+    SimTime toBase(double t) const;                 // User units -> base units
+#ifndef SCHEDULER_NO_JSON
+    nlohmann::json toUnits(SimTime t) const;        // Integers when resolution is 1
+#endif
+    std::string formatTime(SimTime t) const;        // toUnits(t).dump() where JSON is available
+    
     // Helper methods
     void checkArrivals();              // Move arrived processes to ready queue
     void preemptCPU();                 // Move CPU process back to ready queue
@@ -83,13 +534,108 @@ private:
     void executeProcess();             // Execute current CPU process for one tick
     void applyAging();                 // Apply aging to ready queue processes
     void updateWaitingTimes();         // Update waiting times for ready processes
+    std::string endTick(std::string log);  // Retain the log, advance the clock, publish the tick
+    
+    // Lookup index helpers
+    void track(const Process& p, uint8_t where, int32_t container, size_t pos);  // Record a move
+    void renumber(const std::vector<Process>& queue, size_t from);  // Positions of queue[from, end)
+    void swapReady(size_t a, size_t b);  // Swap two readyQueue entries and their positions
+    void trimTimeline(size_t keep);    // Keep the newest 'keep' timeline entries
+    void retainLog(const std::string& log);  // Append a tick log to the log ring
+    const Process* locate(int slot) const;  // Current record, nullptr while in flight between containers
+    Process* findProcess(int id);
+    const std::vector<uint32_t>& finishedOrderFor(const std::string& sortBy);
+    
+    // Decision explanation helpers; beginDecision returns nullptr when disabled
+    DecisionRecord* beginDecision(DecisionRecord::Kind kind, const char* rule,
+                                  int chosenId, int preemptedId);
+    void addCandidate(DecisionRecord& record, const Process& p);
+    void addCandidates(DecisionRecord& record, const std::vector<Process>& ranked);
+    void handlePreemption(std::stringstream& log, std::vector<Process>& queue,
+                          const std::string& algo, SimTime quantum);
+    void dispatchFrom(std::vector<Process>& queue, const std::string& algo);
+    void dispatchAt(std::vector<Process>& queue, size_t index);  // Move queue[index] to the CPU
+    
+    // Multilevel queue helpers
+    int readyClassOf(const Process& p) const;               // Class index, -1 = main ready queue
+    std::vector<Process>& readyQueueFor(const Process& p);  // Target queue for a process
+    void pushReady(Process p);                              // Append to its ready queue, indexed
+    int highestReadyClass() const;     // Lowest-index class with ready work, -1 if none
+    int nextReadyClass(int from) const; // Next class with ready work after 'from', -1 if none
+    void handleMultilevelPreemption(std::stringstream& log);
+    void scheduleMultilevel();
+    
+    // Resource lock helpers
+    void acquireLocks(std::stringstream& log);          // Grant or block at acquire offsets
+    void releaseLocks(Process& p, bool all, std::stringstream& log);
+    int dueLockRequest(const Process& p) const;         // Request to acquire now, -1 if none
+    void grantLock(Process& p, int request);
+    void boostPriority(Process& p, int priority);
+    void restorePriority(Process& p);
+    void propagateInheritance(int holderId, int priority);
+    void accountBlocked();             // Blocked/inversion time for parked processes
+    Process* findActive(int id);       // CPU, ready queues or lock waiters, else nullptr
+    
+    // Gang scheduling helpers
+    std::string tickGang();
+    void resetCores();
+    bool allocateCores(int count, std::vector<int>& cores);  // Lowest free cores first
+    void releaseCores(Process& p);
+    void dispatchGangs(std::stringstream& log);
+    
+    // Arrival pool helpers
+    void addToPool(Process p);         // Index it and schedule its arrival
+    void swapRemove(std::vector<Process>& queue, size_t pos);  // Keeps slotPos of the moved process current
+    std::vector<const Process*> jobPoolInOrder() const;       // addProcess order, for state output
+    
+    // Workflow DAG helpers
+    void holdDependents();             // Move jobPool processes with pending parents to heldProcesses
+    void releaseDependents(const Process& p);  // After 'p' finished
+    
+    // Energy / DVFS helpers
+    void ensureFrequencyStates();
+    int referenceFrequency() const;
+    int applyGovernor(int core);       // Picks the core's level for this tick, returns MHz
+    void advanceWork(Process& p, int mhz);
+    void accountEnergy(int core, bool busy);
+    
+    // Priority expression helpers
+    double scoreOf(const Process& p) const;
+    size_t bestByExpression();         // Index in readyQueue, queue non-empty
+    void siftExprUp(size_t pos);       // Restore the expression heap above readyQueue[pos]
+    void siftExprDown(size_t size);    // Restore readyQueue[0, size) below the root
+    void dispatchByExpression();
+    void handleExpressionPreemption(std::stringstream& log);
+    
+    // Response-ratio helpers
+    void resetRatioHeap();
+    void advanceRatioHeap();           // Repair failed certificates, then push in the tail
+    void swapRatioParent(size_t pos);  // Swap heap[pos] with its parent and refresh nearby certificates
+    void refreshRatioCert(size_t pos);
+    void dispatchByResponseRatio();
+    void handleResponseRatioPreemption(std::stringstream& log);
+    
+    // Plug-in policy helpers
+    bool policyWants(uint32_t hook) const;       // Active policy declared 'hook'
+    const sched_policy_view& stagePolicyView();
+    void handlePolicyPreemption(std::stringstream& log);
+    
+    // Burst prediction helpers
+    SimTime predictBurst(const std::string& name) const;
+    void observeBurst(const Process& p);              // Learn from a finished process
+    SimTime visibleBurst(const Process& p) const;     // What SJF orders by
+    SimTime visibleRemaining(const Process& p) const; // What SRTF orders by
     
     // Algorithm-specific helpers
-    void sortBySJF();                  // Sort by burst time
-    void sortBySRTF();                 // Sort by remaining time
-    void sortByPriority();             // Sort by priority value
-    bool shouldPreemptSRTF();          // Check SRTF preemption condition
-    bool shouldPreemptPriority();      // Check Priority preemption condition
+    void sortBySJF(std::vector<Process>& queue);       // Sort by burst time
+    void sortBySRTF(std::vector<Process>& queue);      // Sort by remaining time
+    void sortByPriority(std::vector<Process>& queue);  // Sort by priority value
+    void sortByResponseRatio(std::vector<Process>& queue);  // Highest response ratio first
+    bool shouldPreemptSRTF(const std::vector<Process>& queue);      // Check SRTF preemption condition
+    bool shouldPreemptPriority(const std::vector<Process>& queue);  // Check Priority preemption condition
+    size_t shortestRemainingIndex(const std::vector<Process>& queue) const;  // First minimum, queue non-empty
+    size_t highestPriorityIndex(const std::vector<Process>& queue) const;    // First minimum, queue non-empty
+    size_t highestRatioIndex(const std::vector<Process>& queue);       // Queue non-empty
 };
 
 #endif
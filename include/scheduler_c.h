@@ -0,0 +1,164 @@
+#ifndef SCHEDULER_C_H
+#define SCHEDULER_C_H
+
+/**
+ * Stable C ABI of the scheduler (libscheduler.so / scheduler.dll)
+ *
+ * - Opaque handles; one handle must not be used from two threads at once
+ *   (different handles are independent)
+ * - Bulk, columnar entry points: whole workloads go in and whole result columns
+ *   come out through caller-provided buffers. Nothing allocated by the library
+ *   is handed to the caller except the handle itself
+ * - Functions never throw; they return SCHED_OK (0) or a negative SCHED_E_* code,
+ *   and sched_last_error() describes the last failure on that handle
+ * - Times are in user-facing time units (see sched_set_time_resolution)
+ * - Additions keep SCHED_ABI_VERSION's meaning; removals or signature changes bump it
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(SCHED_BUILDING_LIBRARY)
+#    define SCHED_API __declspec(dllexport)
+#  else
+#    define SCHED_API __declspec(dllimport)
+#  endif
+#else
+#  define SCHED_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_ABI_VERSION 1
+
+enum {
+    SCHED_OK = 0,
+    SCHED_E_INVALID_ARGUMENT = -1,   /* Null handle/buffer or out-of-range value */
+    SCHED_E_DUPLICATE_ID = -2,
+    SCHED_E_UNKNOWN_ALGORITHM = -3,
+    SCHED_E_PARSE = -4,              /* Scenario text failed validation */
+    SCHED_E_INTERNAL = -5,
+    SCHED_E_PLUGIN = -6              /* Policy plug-in failed to load or was rejected */
+};
+
+/* Process states in sched_get_table (same values as the WASM process table) */
+enum {
+    SCHED_STATE_NOT_ARRIVED = 0,
+    SCHED_STATE_READY = 1,
+    SCHED_STATE_RUNNING = 2,
+    SCHED_STATE_FINISHED = 3,
+    SCHED_STATE_BLOCKED = 4
+};
+
+typedef struct sched_handle sched_handle;
+
+typedef struct {
+    int64_t ticks;        /* Ticks executed by this call */
+    double time;          /* Simulation time reached */
+    int32_t finished;     /* 1 if every process has completed */
+} sched_run_result;
+
+typedef struct {
+    int64_t finished_count;
+    double avg_waiting;
+    double avg_turnaround;
+    double avg_response;
+    double max_response;
+    double makespan;      /* Current simulation time */
+    double throughput;    /* Finished processes per time unit */
+} sched_metrics;
+
+typedef struct {
+    double critical_path; /* Lower bound on makespan with unlimited CPUs */
+    double work;          /* Sum of bursts: lower bound on one CPU */
+    double makespan;      /* Latest completion so far */
+    int64_t held;         /* Processes still waiting on a parent */
+} sched_dag_metrics;
+
+SCHED_API uint32_t sched_abi_version(void);
+
+SCHED_API sched_handle* sched_create(void);
+SCHED_API void sched_destroy(sched_handle* h);
+
+/* Message for the last failed call on 'h' (owned by the handle, valid until its next call) */
+SCHED_API const char* sched_last_error(const sched_handle* h);
+
+/* Configuration (call before loading processes) */
+SCHED_API int sched_set_algorithm(sched_handle* h, const char* algorithm);
+SCHED_API int sched_set_time_quantum(sched_handle* h, double quantum);
+SCHED_API int sched_set_aging(sched_handle* h, int enabled, double threshold, int boost);
+SCHED_API int sched_set_time_resolution(sched_handle* h, int64_t units_per_time);
+SCHED_API int sched_set_context_switch(sched_handle* h, double cost);
+
+/* Use a priority expression (see include/priority_expr.h); replaces the algorithm
+ * with "ExprP" when 'preemptive' is non-zero, "Expr" otherwise */
+SCHED_API int sched_set_priority_expression(sched_handle* h, const char* expression, int preemptive);
+
+/* Non-clairvoyant SJF / SRTF: "None", "EWMA" or "Quantile" with 'param' in (0, 1] and the
+ * prediction used before anything has finished (see Scheduler::setBurstPredictor) */
+SCHED_API int sched_set_burst_predictor(sched_handle* h, const char* predictor, double param, double initial_guess);
+
+/* Use the policy plug-in at 'path' (see include/scheduler_policy.h); replaces the algorithm */
+SCHED_API int sched_set_policy_plugin(sched_handle* h, const char* path);
+
+/**
+ * Add 'count' processes from parallel columns. 'names' may be NULL ("P<id>")
+ * All-or-nothing: ids must be >= 0 and unused, arrivals >= 0, bursts > 0,
+ * priorities >= 0; on error nothing is added
+ */
+SCHED_API int sched_load(sched_handle* h, size_t count, const int32_t* ids, const double* arrival,
+                         const double* burst, const int32_t* priority, const char* const* names);
+
+/**
+ * Add 'count' edges: children[i] arrives once parents[i] (and its other parents)
+ * have finished (see Scheduler::addDependency). All-or-nothing: both ids must be
+ * loaded, the parent before the child, and the child must not have arrived yet
+ */
+SCHED_API int sched_add_dependencies(sched_handle* h, size_t count, const int32_t* parents,
+                                     const int32_t* children);
+
+/**
+ * Configure and load from scenario text (see include/scenario.h); all-or-nothing
+ */
+SCHED_API int sched_load_scenario(sched_handle* h, const char* text, size_t length);
+
+/**
+ * Tick until the simulation time reaches 'until' (< 0 = no limit), every
+ * process has finished, or 'max_ticks' ticks have run (0 = no limit)
+ * 'result' may be NULL
+ */
+SCHED_API int sched_run_until(sched_handle* h, double until, int64_t max_ticks, sched_run_result* result);
+
+SCHED_API double sched_current_time(const sched_handle* h);
+SCHED_API int sched_is_finished(const sched_handle* h);
+SCHED_API size_t sched_process_count(const sched_handle* h);
+SCHED_API size_t sched_finished_count(const sched_handle* h);
+SCHED_API uint64_t sched_state_hash(const sched_handle* h);
+SCHED_API int sched_get_metrics(const sched_handle* h, sched_metrics* out);
+SCHED_API int sched_get_dag_metrics(const sched_handle* h, sched_dag_metrics* out);
+
+/**
+ * Copy rows [offset, offset + count) of the finished processes (finish order)
+ * into the given columns; any column may be NULL. Returns rows written (>= 0)
+ * or an error code
+ */
+SCHED_API int64_t sched_get_finished(sched_handle* h, size_t offset, size_t count, int32_t* ids,
+                                     double* arrival, double* burst, double* completion, double* waiting,
+                                     double* turnaround, double* response);
+
+/**
+ * Copy rows [offset, offset + count) of the process table (load order) into the
+ * given columns; any column may be NULL. Returns rows written or an error code
+ */
+SCHED_API int64_t sched_get_table(sched_handle* h, size_t offset, size_t count, int32_t* ids, int32_t* state,
+                                  double* remaining, int32_t* priority, double* waiting, double* turnaround,
+                                  double* response);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef SCHEDULER_POLICY_H
+#define SCHEDULER_POLICY_H
+
+/**
+ * Scheduling policy plug-in interface (C ABI, see include/policy_plugin.h for loading)
+ *
+ * A plug-in is a shared object exporting SCHED_POLICY_ENTRY. The engine calls it
+ * once per Scheduler to create a policy instance, then calls only the hooks the
+ * instance declares in 'hooks'; undeclared hooks cost nothing per tick
+ *
+ * - select: pick the ready process to dispatch when the CPU is idle
+ *   (without it, ready processes are dispatched in queue order, like FCFS)
+ * - should_preempt: asked every tick while a process runs and others are ready;
+ *   non-zero sends the running process to the back of the ready queue
+ *   (without it, the policy is non-preemptive)
+ * - on_tick: once at the end of every tick
+ * - on_complete: once per finished process
+ *
+ * Views are read-only and only valid during the call. Times are in base units
+ * (see Scheduler::setTimeResolution)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_POLICY_ABI_VERSION 1
+#define SCHED_POLICY_ENTRY "sched_policy_create"
+
+#if defined(_WIN32)
+#  define SCHED_POLICY_EXPORT __declspec(dllexport)
+#else
+#  define SCHED_POLICY_EXPORT __attribute__((visibility("default")))
+#endif
+
+enum {
+    SCHED_POLICY_HOOK_SELECT = 1,
+    SCHED_POLICY_HOOK_PREEMPT = 2,
+    SCHED_POLICY_HOOK_TICK = 4,
+    SCHED_POLICY_HOOK_COMPLETE = 8
+};
+
+typedef struct {
+    int32_t id;
+    int32_t priority;     /* Current value (after aging / lock boosts), lower = higher */
+    int64_t arrival;
+    int64_t burst;
+    int64_t remaining;
+    int64_t waiting;
+    int64_t start;        /* First dispatch, -1 if it has not run yet */
+} sched_policy_process;
+
+typedef struct {
+    int64_t now;                           /* Start of the current tick */
+    int64_t time_resolution;               /* Base units per time unit */
+    int64_t quantum;                       /* Configured time quantum */
+    int64_t quantum_used;                  /* Ticks the running process has had since dispatch */
+    const sched_policy_process* running;   /* NULL when the CPU is idle */
+    const sched_policy_process* ready;     /* Queue order: arrival, then re-queue order */
+    size_t ready_count;
+} sched_policy_view;
+
+typedef struct {
+    uint32_t abi_version;   /* SCHED_POLICY_ABI_VERSION the plug-in was built against */
+    uint32_t hooks;         /* SCHED_POLICY_HOOK_* the engine should call */
+    const char* name;       /* Shown in decision explanations; must outlive the instance */
+    void* state;            /* Passed back to every hook */
+
+    /* Index into view->ready (out of range = 0) */
+    size_t (*select)(void* state, const sched_policy_view* view);
+    int (*should_preempt)(void* state, const sched_policy_view* view);
+    void (*on_tick)(void* state, const sched_policy_view* view);
+    void (*on_complete)(void* state, const sched_policy_process* finished, int64_t now);
+    void (*destroy)(void* state);   /* May be NULL */
+} sched_policy;
+
+/**
+ * Fill 'out' (zeroed by the host) for a host speaking 'host_abi_version'
+ * Returns 0 on success
+ */
+typedef int (*sched_policy_entry)(uint32_t host_abi_version, sched_policy* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
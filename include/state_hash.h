@@ -0,0 +1,69 @@
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "scenario.h"
+
+/**
+ * Hash streams: Scheduler::getStateHash() sampled at tick checkpoints
+ * Two runs of the same scenario agree iff their streams agree; since the hash
+ * is cumulative, every checkpoint after the first divergent tick differs too,
+ * which is what makes bisection work
+ *
+ * Text form (the same from every recorder, native or WASM):
+ *   # scheduler-hash-stream 1
+ *   <tick> <16 hex digits>        one line per checkpoint
+ *   end <tick> <16 hex digits>    when the run finished inside the range
+ */
+
+struct HashCheckpoint {
+    SimTime tick;              // Ticks executed (0 = after setup, before the first tick)
+    uint64_t hash;
+};
+
+struct HashStream {
+    std::vector<HashCheckpoint> checkpoints;
+    bool finished = false;     // Last checkpoint is the end of the run
+};
+
+/**
+ * Run 'scenario' natively, recording every 'every'-th tick in [from, to]
+ * (to < 0 = until finished) plus the final tick. Stops at 'maxTicks'
+ */
+HashStream recordHashStream(const Scenario& scenario, SimTime every, SimTime from = 0, SimTime to = -1,
+                            SimTime maxTicks = 100000000);
+
+std::string formatHashStream(const HashStream& stream);
+bool parseHashStream(const std::string& text, HashStream& out, std::string& error);
+
+/**
+ * Where two streams first disagree
+ * The first divergent tick lies in (lastAgree, firstDiffer]; 'exact' when
+ * that interval is a single tick
+ */
+struct HashDivergence {
+    bool diverged = false;
+    SimTime lastAgree = -1;    // -1 if they disagree from the start
+    SimTime firstDiffer = -1;
+    bool exact = false;
+    std::string detail;
+};
+
+HashDivergence compareHashStreams(const HashStream& a, const HashStream& b);
+
+/**
+ * Records a stream for (from, to, every); must be deterministic
+ */
+typedef std::function<HashStream(SimTime from, SimTime to, SimTime every)> HashRecorder;
+
+/**
+ * Compare coarse streams every 'every' ticks, then re-record both sides over the
+ * divergent interval at finer spacing until the first divergent tick is exact
+ */
+HashDivergence bisectDivergence(const HashRecorder& a, const HashRecorder& b, SimTime every);
+
+#endif
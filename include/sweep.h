@@ -0,0 +1,89 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+/**
+ * Process definition shared by batch runs (times in user units)
+ */
+struct ProcessSpec {
+    int id;
+    std::string name;
+    double arrivalTime;
+    double burstTime;
+    int priority;
+};
+
+/**
+ * Workflow edge: 'child' arrives only after 'parent' has finished
+ * (see Scheduler::addDependency; the parent must be listed first)
+ */
+struct DependencySpec {
+    int parent;
+    int child;
+};
+
+/**
+ * One configuration to simulate in a sweep
+ */
+struct SweepJob {
+    std::string algorithm = "FCFS";
+    double timeQuantum = 2;
+    bool agingEnabled = false;
+    double agingThreshold = 5;
+    int agingBoostAmount = 1;
+    std::string expression;        // Priority expression for "Expr" / "ExprP"
+    std::string predictor;         // Burst predictor for SJF / SRTF, "" = true bursts
+    double predictorParam = 0.5;
+};
+
+/**
+ * Aggregate metrics of one completed sweep job (times in user units)
+ */
+struct SweepResult {
+    SweepJob job;
+    double avgWaitingTime = 0;
+    double avgTurnaroundTime = 0;
+    double avgResponseTime = 0;
+    double maxResponseTime = 0;
+    double makespan = 0;
+    double throughput = 0;         // Finished processes per time unit
+    long long ticks = 0;
+    // Jobs with a predictor only
+    double predictionError = 0;    // Mean |predicted - true burst|
+    double regret = 0;             // Avg waiting time minus that of the same job with true bursts
+    // Jobs over dependencies only
+    double criticalPath = 0;       // Makespan lower bound with unlimited CPUs (see DagMetrics)
+};
+
+/**
+ * Run every job over the same workload on a pool of 'threads' workers
+ * Results are returned in job order regardless of completion order
+ */
+std::vector<SweepResult> runSweep(const std::vector<ProcessSpec>& processes,
+                                  const std::vector<SweepJob>& jobs,
+                                  int threads,
+                                  const std::vector<DependencySpec>& dependencies = {});
+
+/**
+ * Run a single job to completion on the calling thread
+ */
+SweepResult runSweepJob(const std::vector<ProcessSpec>& processes, const SweepJob& job,
+                        const std::vector<DependencySpec>& dependencies = {});
+
+/**
+ * JSON front end used by the WASM bindings
+ * Request: {"processes": [{id, name, arrival, burst, priority}], "dependencies": [{parent, child}],
+ *          "jobs": [{algorithm, quantum, aging, aging_threshold, aging_boost, expression,
+ *          predictor, predictor_param}], "threads": n}
+ * Response: {"results": [...], "best": {metric: job index}}; prediction jobs add
+ *           "prediction_error" and "regret", and every job "critical_path" with dependencies
+ *           or {"error": "..."} if a job's expression does not compile, its predictor is unknown
+ *           or a dependency names an unknown id or a parent listed after its child
+ */
+nlohmann::json runSweepJSON(const nlohmann::json& request, int maxThreads);
+
+#endif
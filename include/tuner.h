@@ -0,0 +1,118 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "scenario.h"
+
+/**
+ * Configuration tuner
+ * Searches timeQuantum / agingThreshold / agingBoostAmount (and optionally the
+ * algorithm) for an objective such as
+ *   minimize p99_response_time subject to throughput >= 0.4
+ * with successive halving: every candidate gets a short run, the better 1/eta
+ * and the rung's Pareto front over the objective and constraint metrics
+ * continue to a longer one, and the last rung runs to completion. Candidates
+ * keep their Scheduler between rungs, so a promoted run resumes where it stopped
+ */
+
+/**
+ * Metrics of one (possibly partial) run, times in user units
+ * Partial runs count processes that have arrived but not yet started with their
+ * response time so far (a lower bound), so starving configurations look bad early
+ */
+struct TuneMetrics {
+    double avgWaitingTime = 0;
+    double avgTurnaroundTime = 0;
+    double avgResponseTime = 0;
+    double p99ResponseTime = 0;
+    double maxResponseTime = 0;
+    double makespan = 0;
+    double throughput = 0;       // Finished processes per time unit
+    bool complete = false;       // Ran to completion
+};
+
+/**
+ * Metric names, as in the sweep JSON: avg_waiting_time, avg_turnaround_time,
+ * avg_response_time, p99_response_time, max_response_time, makespan, throughput
+ */
+bool isTuneMetric(const std::string& name);
+double tuneMetric(const TuneMetrics& m, const std::string& name);
+
+struct TuneConstraint {
+    std::string metric;
+    bool atLeast;                // true: metric >= bound, false: metric <= bound
+    double bound;
+};
+
+struct TuneObjective {
+    std::string metric = "avg_waiting_time";
+    bool maximize = false;
+    std::vector<TuneConstraint> constraints;
+};
+
+/**
+ * "minimize|maximize <metric> [subject to <metric> >=|<= <number>[, ...]]"
+ */
+bool parseTuneObjective(const std::string& text, TuneObjective& out, std::string& error);
+
+/**
+ * Search space; integer ranges are inclusive and sampled log-uniformly
+ * Parameters an algorithm ignores are pinned (quantum outside RR, aging for
+ * algorithms that never read priorities, aging parameters when aging is off)
+ * so equivalent candidates are not run twice
+ */
+struct TuneSpace {
+    std::vector<std::string> algorithms;   // Empty = the scenario's algorithm
+    int quantumMin = 1;
+    int quantumMax = 16;
+    bool tuneAging = true;                 // Try aging off and on
+    int thresholdMin = 1;
+    int thresholdMax = 64;
+    int boostMin = 1;
+    int boostMax = 8;
+};
+
+struct TuneOptions {
+    int candidates = 64;
+    int eta = 3;                 // Keep the best 1/eta at every rung
+    int threads = 4;
+    uint64_t seed = 1;
+};
+
+struct TuneCandidate {
+    SweepJob config;
+    TuneMetrics metrics;         // From the last rung it ran
+    int rung = 0;                // Last rung reached (rungs - 1 = ran to completion)
+    bool feasible = false;       // Constraints hold on 'metrics'
+};
+
+struct TuneResult {
+    std::vector<TuneCandidate> candidates;  // Sampling order; candidate 0 is the scenario's own config
+    std::vector<long long> rungTicks;       // Tick budget per rung, the last is "to completion" (-1)
+    int best = -1;                          // Best feasible complete candidate, -1 if none
+    std::vector<int> pareto;                // Complete candidates not dominated on the objective
+                                            // and constraint metrics, best objective first
+};
+
+/**
+ * Tune 'scenario' (its processes, time resolution and context-switch cost are kept)
+ * Deterministic for a given seed regardless of 'threads'
+ */
+TuneResult tuneScenario(const Scenario& scenario, const TuneObjective& objective, const TuneSpace& space,
+                        const TuneOptions& options);
+
+/**
+ * JSON front end used by the WASM bindings
+ * Request: {"scenario": text, "objective": text, "candidates", "eta", "seed",
+ *           "space": {"algorithms": [...], "quantum": [min, max], "aging": bool,
+ *                     "aging_threshold": [min, max], "aging_boost": [min, max]}}
+ * Response: {"candidates": [{algorithm, quantum, aging, aging_threshold, aging_boost,
+ *            rung, feasible, complete, <metrics>}], "rung_ticks", "best", "pareto"}
+ *           or {"error": "..."}
+ */
+nlohmann::json runTuneJSON(const nlohmann::json& request, int maxThreads);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef WORKLOADS_H
+#define WORKLOADS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "scenario.h"
+
+/**
+ * Named benchmark workloads, each built around a classic scheduling pathology
+ * Generation is deterministic: the same name, count and seed always give the
+ * same scenario, so engine versions can be compared on identical inputs
+ * (the generator uses its own PRNG and distributions, not <random>'s, whose
+ * output differs between standard libraries)
+ */
+
+const uint64_t WORKLOAD_DEFAULT_SEED = 1;
+
+/**
+ * Standard sizes for benchmark tables (any count >= 1 can be generated)
+ */
+const size_t WORKLOAD_SIZES[] = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+struct WorkloadInfo {
+    std::string name;
+    std::string description;
+    std::string algorithm;  // Policy the pathology shows up under (set in the scenario config)
+};
+
+/**
+ * Every available workload, in a stable order
+ */
+const std::vector<WorkloadInfo>& listWorkloads();
+
+/**
+ * Generate 'count' processes (ids 1..count) of workload 'name' into 'out'
+ * Returns false for an unknown name or count == 0
+ */
+bool generateWorkload(const std::string& name, size_t count, uint64_t seed, Scenario& out);
+
+/**
+ * JSON front end used by the WASM bindings: [{name, description, algorithm}]
+ */
+nlohmann::json listWorkloadsJSON();
+
+#endif
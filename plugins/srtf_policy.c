@@ -0,0 +1,44 @@
+/**
+ * Example policy plug-in: Shortest Remaining Time First
+ * Makes the same decisions as the built-in "SRTF", so it doubles as a template
+ * and as a check that the plug-in path matches the engine
+ *
+ *   cc -shared -fPIC -Iinclude plugins/srtf_policy.c -o libsrtf_policy.so
+ */
+
+#include "scheduler_policy.h"
+
+/* Same order as Scheduler::sortBySRTF: remaining, then arrival, then id */
+static int before(const sched_policy_process* a, const sched_policy_process* b) {
+    if (a->remaining != b->remaining) return a->remaining < b->remaining;
+    if (a->arrival != b->arrival) return a->arrival < b->arrival;
+    return a->id < b->id;
+}
+
+static size_t shortest(const sched_policy_view* view) {
+    size_t best = 0;
+    for (size_t i = 1; i < view->ready_count; ++i) {
+        if (before(&view->ready[i], &view->ready[best])) best = i;
+    }
+    return best;
+}
+
+static size_t srtf_select(void* state, const sched_policy_view* view) {
+    (void)state;
+    return shortest(view);
+}
+
+static int srtf_should_preempt(void* state, const sched_policy_view* view) {
+    (void)state;
+    return view->ready[shortest(view)].remaining < view->running->remaining;
+}
+
+SCHED_POLICY_EXPORT int sched_policy_create(uint32_t host_abi_version, sched_policy* out) {
+    if (host_abi_version < 1) return -1;
+    out->abi_version = SCHED_POLICY_ABI_VERSION;
+    out->hooks = SCHED_POLICY_HOOK_SELECT | SCHED_POLICY_HOOK_PREEMPT;
+    out->name = "SRTF";
+    out->select = srtf_select;
+    out->should_preempt = srtf_should_preempt;
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "state_hash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+/**
+ * Determinism checks over state-hash streams
+ *   scheduler_hashcheck record <scenario> [--every K] [--from T] [--to T]
+ *   scheduler_hashcheck compare <streamA> <streamB>
+ *   scheduler_hashcheck bisect <scenario> [--every K] [--a CMD] [--b CMD]
+ * bisect re-runs both sides over narrowing tick ranges. A side is this native
+ * build unless CMD is given: a command template whose stdout is a stream, with
+ * {scenario} {from} {to} {every} substituted, e.g.
+ *   --b "node tools/hash_record.js {scenario} --from {from} --to {to} --every {every}"
+ * Exit status: 0 = agree, 1 = diverged, 2 = usage or input error
+ */
+
+namespace {
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string substitute(std::string text, const std::string& key, const std::string& value) {
+    for (size_t pos = text.find(key); pos != std::string::npos; pos = text.find(key, pos + value.size())) {
+        text.replace(pos, key.size(), value);
+    }
+    return text;
+}
+
+/**
+ * Recorder that runs an external command and parses its stdout
+ */
+HashRecorder commandRecorder(const std::string& command, const std::string& scenarioPath) {
+    return [command, scenarioPath](SimTime from, SimTime to, SimTime every) {
+        std::string cmd = substitute(command, "{scenario}", scenarioPath);
+        cmd = substitute(cmd, "{from}", std::to_string(from));
+        cmd = substitute(cmd, "{to}", std::to_string(to));
+        cmd = substitute(cmd, "{every}", std::to_string(every));
+
+        std::string output;
+        if (FILE* pipe = popen(cmd.c_str(), "r")) {
+            char buffer[4096];
+            size_t n;
+            while ((n = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0) output.append(buffer, n);
+            pclose(pipe);
+        }
+        HashStream stream;
+        std::string error;
+        if (!parseHashStream(output, stream, error)) {
+            std::cerr << "Error: '" << cmd << "': " << error << std::endl;
+            std::exit(2);
+        }
+        return stream;
+    };
+}
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " record <scenario> [--every K] [--from T] [--to T]\n"
+              << "       " << program << " compare <streamA> <streamB>\n"
+              << "       " << program << " bisect <scenario> [--every K] [--a CMD] [--b CMD]\n";
+    return 2;
+}
+
+bool loadScenario(const std::string& path, Scenario& scenario) {
+    std::vector<ScenarioError> errors;
+    if (loadScenarioFile(path, scenario, errors)) return true;
+    for (const auto& e : errors) {
+        std::cerr << path << ":" << e.line << ": " << e.message << "\n";
+    }
+    return false;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage(argv[0]);
+    std::string command = argv[1];
+
+    if (command == "compare") {
+        if (argc != 4) return usage(argv[0]);
+        HashStream streams[2];
+        for (int i = 0; i < 2; ++i) {
+            std::string text, error;
+            if (!readFile(argv[2 + i], text) || !parseHashStream(text, streams[i], error)) {
+                std::cerr << "Error: " << argv[2 + i] << ": " << (error.empty() ? "cannot read" : error) << std::endl;
+                return 2;
+            }
+        }
+        HashDivergence d = compareHashStreams(streams[0], streams[1]);
+        std::cout << d.detail << std::endl;
+        if (d.diverged && !d.exact) {
+            std::cout << "Re-record both with --from " << std::max<SimTime>(0, d.lastAgree) << " --to "
+                      << d.firstDiffer << " --every 1 to find the exact tick" << std::endl;
+        }
+        return d.diverged ? 1 : 0;
+    }
+
+    if (command != "record" && command != "bisect") return usage(argv[0]);
+
+    std::string scenarioPath = argv[2];
+    SimTime every = 1000, from = 0, to = -1;
+    std::string commandA, commandB;
+    for (int i = 3; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (i + 1 >= argc) return usage(argv[0]);
+        if (opt == "--every") every = std::strtoll(argv[++i], nullptr, 10);
+        else if (opt == "--from" && command == "record") from = std::strtoll(argv[++i], nullptr, 10);
+        else if (opt == "--to" && command == "record") to = std::strtoll(argv[++i], nullptr, 10);
+        else if (opt == "--a" && command == "bisect") commandA = argv[++i];
+        else if (opt == "--b" && command == "bisect") commandB = argv[++i];
+        else return usage(argv[0]);
+    }
+
+    Scenario scenario;
+    if (!loadScenario(scenarioPath, scenario)) return 2;
+
+    if (command == "record") {
+        std::cout << formatHashStream(recordHashStream(scenario, every, from, to));
+        return 0;
+    }
+
+    HashRecorder native = [&scenario](SimTime f, SimTime t, SimTime e) {
+        return recordHashStream(scenario, e, f, t);
+    };
+    HashRecorder a = commandA.empty() ? native : commandRecorder(commandA, scenarioPath);
+    HashRecorder b = commandB.empty() ? native : commandRecorder(commandB, scenarioPath);
+    HashDivergence d = bisectDivergence(a, b, every);
+    std::cout << d.detail << std::endl;
+    return d.diverged ? 1 : 0;
+}
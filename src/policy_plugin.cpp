@@ -0,0 +1,74 @@
+#include "policy_plugin.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <dlfcn.h>
+#endif
+
+std::shared_ptr<PolicyInstance> createPolicy(sched_policy_entry entry, std::string& error) {
+    if (!entry) {
+        error = "no policy entry point";
+        return nullptr;
+    }
+
+    auto policy = std::make_shared<PolicyInstance>();
+    if (entry(SCHED_POLICY_ABI_VERSION, &policy->table) != 0) {
+        policy->table.destroy = nullptr;  // Nothing was created
+        error = "policy entry point failed";
+        return nullptr;
+    }
+
+    const sched_policy& t = policy->table;
+    if (t.abi_version != SCHED_POLICY_ABI_VERSION) {
+        error = "policy ABI version " + std::to_string(t.abi_version) + " (this build speaks " +
+                std::to_string(SCHED_POLICY_ABI_VERSION) + ")";
+        return nullptr;
+    }
+    if (!t.name || !*t.name) {
+        error = "policy has no name";
+        return nullptr;
+    }
+    if ((policy->wants(SCHED_POLICY_HOOK_SELECT) && !t.select) ||
+        (policy->wants(SCHED_POLICY_HOOK_PREEMPT) && !t.should_preempt) ||
+        (policy->wants(SCHED_POLICY_HOOK_TICK) && !t.on_tick) ||
+        (policy->wants(SCHED_POLICY_HOOK_COMPLETE) && !t.on_complete)) {
+        error = std::string("policy '") + t.name + "' declares a hook it does not provide";
+        return nullptr;
+    }
+    return policy;
+}
+
+std::shared_ptr<PolicyInstance> loadPolicy(const std::string& path, std::string& error) {
+#if defined(__EMSCRIPTEN__)
+    error = "policy plug-ins are not available in this build";
+    return nullptr;
+#else
+#if defined(_WIN32)
+    HMODULE handle = LoadLibraryA(path.c_str());
+    if (!handle) {
+        error = "cannot load " + path + " (error " + std::to_string(GetLastError()) + ")";
+        return nullptr;
+    }
+    std::shared_ptr<void> library(handle, [](void* h) { FreeLibrary(static_cast<HMODULE>(h)); });
+    auto entry = reinterpret_cast<sched_policy_entry>(GetProcAddress(handle, SCHED_POLICY_ENTRY));
+#else
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        const char* message = dlerror();
+        error = message ? message : "cannot load " + path;
+        return nullptr;
+    }
+    std::shared_ptr<void> library(handle, [](void* h) { dlclose(h); });
+    auto entry = reinterpret_cast<sched_policy_entry>(dlsym(handle, SCHED_POLICY_ENTRY));
+#endif
+    if (!entry) {
+        error = path + " does not export " + SCHED_POLICY_ENTRY;
+        return nullptr;
+    }
+
+    std::shared_ptr<PolicyInstance> policy = createPolicy(entry, error);
+    if (policy) policy->library = library;
+    return policy;
+#endif
+}
@@ -0,0 +1,235 @@
+#include "priority_expr.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const char* const FIELD_NAMES[PriorityExpr::FIELD_COUNT] = {
+    "id", "priority", "arrival", "burst", "remaining", "executed", "waiting", "age", "now"
+};
+
+}
+
+/**
+ * Recursive-descent parser emitting postfix code
+ *   expr  := term (('+' | '-') term)*
+ *   term  := unary (('*' | '/') unary)*
+ *   unary := '-' unary | primary
+ *   primary := number | field | name '(' expr (',' expr)* ')' | '(' expr ')'
+ */
+class ExprParser {
+public:
+    ExprParser(const std::string& text, std::vector<PriorityExpr::Op>& out, uint32_t& mask)
+        : s(text), code(out), fieldMask(mask) {}
+
+    bool parse(std::string& error) {
+        skipSpace();
+        if (pos == s.size()) return fail("empty expression", error);
+        if (!expr(error)) return false;
+        if (pos != s.size()) return fail("unexpected '" + std::string(1, s[pos]) + "'", error);
+        return true;
+    }
+
+private:
+    typedef PriorityExpr::Op Op;
+    const std::string& s;
+    std::vector<Op>& code;
+    uint32_t& fieldMask;
+    size_t pos = 0;
+    int nesting = 0;   // Bounds recursion on inputs like "((((..."
+
+    bool fail(const std::string& message, std::string& error) {
+        error = "column " + std::to_string(pos + 1) + ": " + message;
+        return false;
+    }
+
+    void skipSpace() {
+        while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) pos++;
+    }
+
+    bool accept(char c) {
+        if (pos < s.size() && s[pos] == c) {
+            pos++;
+            skipSpace();
+            return true;
+        }
+        return false;
+    }
+
+    bool isConst(size_t fromEnd) const {
+        return code.size() >= fromEnd && code[code.size() - fromEnd].code == PriorityExpr::CONST;
+    }
+
+    // Append an operator, folding it when every operand is a constant
+    void emit(PriorityExpr::OpCode op, int arity) {
+        if (isConst(1) && (arity == 1 || isConst(2))) {
+            double b = code.back().value;
+            double a = arity == 2 ? code[code.size() - 2].value : 0;
+            code.resize(code.size() - arity);
+            double folded = 0;
+            switch (op) {
+                case PriorityExpr::ADD: folded = a + b; break;
+                case PriorityExpr::SUB: folded = a - b; break;
+                case PriorityExpr::MUL: folded = a * b; break;
+                case PriorityExpr::DIV: folded = a / b; break;
+                case PriorityExpr::NEG: folded = -b; break;
+                case PriorityExpr::MIN: folded = std::min(a, b); break;
+                case PriorityExpr::MAX: folded = std::max(a, b); break;
+                case PriorityExpr::ABS: folded = std::fabs(b); break;
+                default: break;
+            }
+            code.push_back({PriorityExpr::CONST, 0, folded});
+            return;
+        }
+        code.push_back({op, 0, 0});
+    }
+
+    bool expr(std::string& error) {
+        if (nesting >= PriorityExpr::MAX_DEPTH) return fail("expression nests too deeply", error);
+        nesting++;
+        bool ok = term(error);
+        while (ok && pos < s.size() && (s[pos] == '+' || s[pos] == '-')) {
+            PriorityExpr::OpCode op = s[pos] == '+' ? PriorityExpr::ADD : PriorityExpr::SUB;
+            accept(s[pos]);
+            ok = term(error);
+            if (ok) emit(op, 2);
+        }
+        nesting--;
+        return ok;
+    }
+
+    bool term(std::string& error) {
+        if (!unary(error)) return false;
+        while (pos < s.size() && (s[pos] == '*' || s[pos] == '/')) {
+            PriorityExpr::OpCode op = s[pos] == '*' ? PriorityExpr::MUL : PriorityExpr::DIV;
+            accept(s[pos]);
+            if (!unary(error)) return false;
+            emit(op, 2);
+        }
+        return true;
+    }
+
+    bool unary(std::string& error) {
+        if (nesting >= PriorityExpr::MAX_DEPTH) return fail("expression nests too deeply", error);
+        if (accept('-')) {
+            nesting++;
+            bool ok = unary(error);
+            nesting--;
+            if (!ok) return false;
+            emit(PriorityExpr::NEG, 1);
+            return true;
+        }
+        return primary(error);
+    }
+
+    bool primary(std::string& error) {
+        if (pos == s.size()) return fail("unexpected end of expression", error);
+
+        if (accept('(')) {
+            if (!expr(error)) return false;
+            if (!accept(')')) return fail("expected ')'", error);
+            return true;
+        }
+
+        char c = s[pos];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* start = s.c_str() + pos;
+            char* end = nullptr;
+            double value = std::strtod(start, &end);
+            if (end == start) return fail("bad number", error);
+            pos += end - start;
+            skipSpace();
+            code.push_back({PriorityExpr::CONST, 0, value});
+            return true;
+        }
+
+        if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_') {
+            return fail("unexpected '" + std::string(1, c) + "'", error);
+        }
+        size_t start = pos;
+        while (pos < s.size() && (std::isalnum(static_cast<unsigned char>(s[pos])) || s[pos] == '_')) pos++;
+        std::string name = s.substr(start, pos - start);
+        skipSpace();
+
+        if (pos < s.size() && s[pos] == '(') {
+            PriorityExpr::OpCode op;
+            int arity;
+            if (name == "min") { op = PriorityExpr::MIN; arity = 2; }
+            else if (name == "max") { op = PriorityExpr::MAX; arity = 2; }
+            else if (name == "abs") { op = PriorityExpr::ABS; arity = 1; }
+            else {
+                pos = start;
+                return fail("unknown function '" + name + "'", error);
+            }
+            std::string usage = name + "() takes " + std::to_string(arity) + (arity == 1 ? " argument" : " arguments");
+            accept('(');
+            for (int i = 0; i < arity; ++i) {
+                if (i > 0 && !accept(',')) return fail(usage, error);
+                if (!expr(error)) return false;
+            }
+            if (!accept(')')) return fail(usage, error);
+            emit(op, arity);
+            return true;
+        }
+
+        for (uint8_t f = 0; f < PriorityExpr::FIELD_COUNT; ++f) {
+            if (name == FIELD_NAMES[f]) {
+                code.push_back({PriorityExpr::LOAD, f, 0});
+                fieldMask |= 1u << f;
+                return true;
+            }
+        }
+        pos = start;
+        return fail("unknown field '" + name + "'", error);
+    }
+};
+
+bool PriorityExpr::compile(const std::string& text, std::string& error) {
+    std::vector<Op> compiled;
+    uint32_t mask = 0;
+    ExprParser parser(text, compiled, mask);
+    if (!parser.parse(error)) return false;
+
+    // Postfix code of a well-formed expression: depth is the running push/pop balance
+    int depth = 0;
+    int maxDepth = 0;
+    for (const Op& op : compiled) {
+        if (op.code == CONST || op.code == LOAD) depth++;
+        else if (op.code != NEG && op.code != ABS) depth--;
+        maxDepth = std::max(maxDepth, depth);
+    }
+    if (maxDepth > MAX_DEPTH) {
+        error = "expression nests deeper than " + std::to_string(MAX_DEPTH) + " operands";
+        return false;
+    }
+
+    code.swap(compiled);
+    fieldMask = mask;
+    source = text;
+    return true;
+}
+
+double PriorityExpr::evaluate(const double* fields) const {
+    if (code.empty()) return 0;
+
+    double stack[MAX_DEPTH];
+    int top = -1;
+    for (const Op& op : code) {
+        switch (op.code) {
+            case CONST: stack[++top] = op.value; break;
+            case LOAD: stack[++top] = fields[op.field]; break;
+            case ADD: top--; stack[top] += stack[top + 1]; break;
+            case SUB: top--; stack[top] -= stack[top + 1]; break;
+            case MUL: top--; stack[top] *= stack[top + 1]; break;
+            case DIV: top--; stack[top] /= stack[top + 1]; break;
+            case NEG: stack[top] = -stack[top]; break;
+            case MIN: top--; stack[top] = std::min(stack[top], stack[top + 1]); break;
+            case MAX: top--; stack[top] = std::max(stack[top], stack[top + 1]); break;
+            case ABS: stack[top] = std::fabs(stack[top]); break;
+        }
+    }
+    return stack[0];
+}
@@ -0,0 +1,816 @@
+#include "scenario.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+
+const char SCENARIO_FORMAT[] = "scheduler-scenario";
+const char BINARY_MAGIC[4] = {'P', 'S', 'C', 'N'};
+const char* const KNOWN_ALGORITHMS[] = {"FCFS", "SJF", "SRTF", "RR", "Priority", "PriorityNP", "HRRN", "HRRNP", "Gang"};
+
+/**
+ * Collects errors up to SCENARIO_MAX_ERRORS and counts the rest
+ */
+class ErrorSink {
+public:
+    explicit ErrorSink(std::vector<ScenarioError>& errors) : errors(errors) {}
+
+    void add(int line, const std::string& message) {
+        failed = true;
+        if (errors.size() < SCENARIO_MAX_ERRORS) {
+            errors.push_back({line, message});
+        } else {
+            dropped++;
+        }
+    }
+
+    // Returns true if no error was reported
+    bool finish() {
+        if (dropped > 0) {
+            errors.push_back({0, std::to_string(dropped) + " more error(s) not shown"});
+        }
+        return !failed;
+    }
+
+private:
+    std::vector<ScenarioError>& errors;
+    bool failed = false;
+    size_t dropped = 0;
+};
+
+bool isInteger(double v) {
+    return std::isfinite(v) && v == std::floor(v) && v >= -2147483648.0 && v <= 2147483647.0;
+}
+
+void validateConfig(const Scenario& s, int line, ErrorSink& sink) {
+    if (!isKnownAlgorithm(s.config.algorithm)) {
+        sink.add(line, "unknown algorithm \"" + s.config.algorithm + "\"");
+    }
+    if (!(s.config.timeQuantum > 0) || !std::isfinite(s.config.timeQuantum)) {
+        sink.add(line, "quantum must be a positive number");
+    }
+    if (!(s.config.agingThreshold > 0) || !std::isfinite(s.config.agingThreshold)) {
+        sink.add(line, "aging_threshold must be a positive number");
+    }
+    if (s.config.agingBoostAmount < 0) {
+        sink.add(line, "aging_boost must not be negative");
+    }
+    if (s.timeResolution < 1) {
+        sink.add(line, "time_resolution must be at least 1");
+    }
+    if (!(s.contextSwitchCost >= 0) || !std::isfinite(s.contextSwitchCost)) {
+        sink.add(line, "context_switch must not be negative");
+    }
+}
+
+/**
+ * Range checks shared by both forms; 'firstLine' maps ids to where they were defined
+ * Times must also survive conversion to base units at the scenario's resolution
+ */
+void validateProcess(const ProcessSpec& p, int line, ErrorSink& sink,
+                     std::unordered_map<int, int>& firstLine, SimTime timeResolution) {
+    SimTime unit = std::max<SimTime>(1, timeResolution);
+    std::string atResolution = " at time_resolution " + std::to_string(unit);
+    if (p.id < 0) {
+        sink.add(line, "id must not be negative");
+    } else {
+        auto inserted = firstLine.emplace(p.id, line);
+        if (!inserted.second) {
+            sink.add(line, "duplicate id " + std::to_string(p.id) + " (first defined on line " +
+                           std::to_string(inserted.first->second) + ")");
+        }
+    }
+    if (!(p.arrivalTime >= 0) || !std::isfinite(p.arrivalTime)) {
+        sink.add(line, "arrival must be a non-negative number");
+    } else if (!fitsSimTime(p.arrivalTime, unit)) {
+        sink.add(line, "arrival is out of range" + atResolution);
+    }
+    if (!(p.burstTime > 0) || !std::isfinite(p.burstTime)) {
+        sink.add(line, "burst must be a positive number");
+    } else if (!fitsSimTime(p.burstTime, unit)) {
+        sink.add(line, "burst is out of range" + atResolution);
+    } else if (std::llround(p.burstTime * static_cast<double>(unit)) < 1) {
+        sink.add(line, "burst rounds to 0" + atResolution);
+    }
+    if (p.priority < 0) {
+        sink.add(line, "priority must not be negative");
+    }
+}
+
+// === Flat JSON object parsing (process lines) ===
+
+struct FlatValue {
+    enum Kind { STRING, NUMBER, BOOLEAN, NUL } kind = NUL;
+    std::string text;
+    double number = 0;
+};
+
+/**
+ * Parser for one flat JSON object (string, number, boolean and null members)
+ * Process lines are all this shape, and skipping a DOM keeps 1M-line files
+ * well under a second
+ */
+class FlatObjectParser {
+public:
+    FlatObjectParser(const char* begin, const char* end) : p(begin), end(end) {}
+
+    // Calls onField(key, value) per member; returns false with 'error' set on bad syntax
+    template <typename OnField>
+    bool parse(OnField onField, std::string& error) {
+        skipSpace();
+        if (!consume('{')) return fail(error, "expected '{'");
+        skipSpace();
+        if (!consume('}')) {
+            std::string key;
+            FlatValue value;
+            for (;;) {
+                skipSpace();
+                key.clear();
+                if (!parseString(key)) return fail(error, "expected a quoted field name");
+                skipSpace();
+                if (!consume(':')) return fail(error, "expected ':' after \"" + key + "\"");
+                skipSpace();
+                if (!parseValue(value)) return fail(error, "invalid value for \"" + key + "\"");
+                onField(key, value);
+                skipSpace();
+                if (consume(',')) continue;
+                if (consume('}')) break;
+                return fail(error, "expected ',' or '}'");
+            }
+        }
+        skipSpace();
+        if (p != end) return fail(error, "unexpected characters after the object");
+        return true;
+    }
+
+private:
+    const char* p;
+    const char* end;
+
+    bool fail(std::string& error, const std::string& message) {
+        error = message;
+        return false;
+    }
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    }
+
+    bool consume(char c) {
+        if (p < end && *p == c) {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseHex4(unsigned& out) {
+        if (end - p < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *p++;
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= c - '0';
+            else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+        while (p < end) {
+            const char* run = p;
+            while (p < end && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20) ++p;
+            out.append(run, p);
+            if (p == end) return false;
+            char c = *p++;
+            if (c == '"') return true;
+            if (c != '\\' || p == end) return false;  // Raw control character or dangling escape
+
+            char e = *p++;
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned cp;
+                    if (!parseHex4(cp)) return false;
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        unsigned low;
+                        if (!consume('\\') || !consume('u') || !parseHex4(low) ||
+                            low < 0xDC00 || low > 0xDFFF) {
+                            return false;
+                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return false;
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * JSON number grammar; short plain integers skip strtod
+     */
+    bool parseNumber(double& out) {
+        const char* start = p;
+        bool negative = consume('-');
+        const char* digits = p;
+        if (p == end || *p < '0' || *p > '9') return false;
+        if (*p == '0') {
+            ++p;
+        } else {
+            while (p < end && *p >= '0' && *p <= '9') ++p;
+        }
+        bool integral = true;
+        if (p < end && *p == '.') {
+            integral = false;
+            ++p;
+            if (p == end || *p < '0' || *p > '9') return false;
+            while (p < end && *p >= '0' && *p <= '9') ++p;
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            integral = false;
+            ++p;
+            if (p < end && (*p == '+' || *p == '-')) ++p;
+            if (p == end || *p < '0' || *p > '9') return false;
+            while (p < end && *p >= '0' && *p <= '9') ++p;
+        }
+
+        if (integral && p - digits <= 15) {
+            long long v = 0;
+            for (const char* d = digits; d < p; ++d) v = v * 10 + (*d - '0');
+            out = static_cast<double>(negative ? -v : v);
+        } else {
+            out = std::strtod(std::string(start, p).c_str(), nullptr);
+        }
+        return true;
+    }
+
+    bool parseLiteral(const char* word) {
+        size_t n = std::strlen(word);
+        if (static_cast<size_t>(end - p) < n || std::memcmp(p, word, n) != 0) return false;
+        p += n;
+        return true;
+    }
+
+    bool parseValue(FlatValue& value) {
+        if (p == end) return false;
+        switch (*p) {
+            case '"':
+                value.kind = FlatValue::STRING;
+                value.text.clear();
+                return parseString(value.text);
+            case 't':
+                value.kind = FlatValue::BOOLEAN;
+                value.number = 1;
+                return parseLiteral("true");
+            case 'f':
+                value.kind = FlatValue::BOOLEAN;
+                value.number = 0;
+                return parseLiteral("false");
+            case 'n':
+                value.kind = FlatValue::NUL;
+                return parseLiteral("null");
+            default:
+                value.kind = FlatValue::NUMBER;
+                return parseNumber(value.number);
+        }
+    }
+};
+
+/**
+ * Check that every dependency names known processes, the parent defined first
+ * ('firstLine' as filled by validateProcess; 'lines' are where the edges were read)
+ */
+void validateDependencies(const std::vector<DependencySpec>& dependencies, const std::vector<int>& lines,
+                          ErrorSink& sink, const std::unordered_map<int, int>& firstLine) {
+    for (size_t i = 0; i < dependencies.size(); ++i) {
+        const DependencySpec& d = dependencies[i];
+        auto parent = firstLine.find(d.parent);
+        auto child = firstLine.find(d.child);
+        if (parent == firstLine.end() || child == firstLine.end()) {
+            int unknown = parent == firstLine.end() ? d.parent : d.child;
+            sink.add(lines[i], "dependency on unknown id " + std::to_string(unknown));
+        } else if (parent->second >= child->second) {
+            sink.add(lines[i], "parent " + std::to_string(d.parent) + " must be defined before child " +
+                               std::to_string(d.child));
+        }
+    }
+}
+
+/**
+ * Type checks for one process or dependency line; range checks happen in
+ * validateProcess / validateDependencies. 'dependency' tells which one was read
+ */
+bool parseProcessLine(const char* begin, const char* end, int line, ProcessSpec& spec,
+                      DependencySpec& edge, bool& dependency, ErrorSink& sink) {
+    spec = {-1, "", 0.0, 0.0, 0};
+    edge = {-1, -1};
+    bool haveId = false, haveBurst = false, haveName = false, typesOk = true;
+    bool haveParent = false, haveChild = false, haveProcessField = false;
+
+    auto typeError = [&](const std::string& key, const char* expected) {
+        sink.add(line, "\"" + key + "\" must be " + expected);
+        typesOk = false;
+    };
+
+    std::string syntaxError;
+    FlatObjectParser parser(begin, end);
+    bool parsed = parser.parse([&](const std::string& key, const FlatValue& v) {
+        bool number = v.kind == FlatValue::NUMBER;
+        if (key == "parent" || key == "child") {
+            (key == "parent" ? haveParent : haveChild) = true;
+            if (!number || !isInteger(v.number)) return typeError(key, "an integer");
+            (key == "parent" ? edge.parent : edge.child) = static_cast<int>(v.number);
+            return;
+        }
+        haveProcessField = true;
+        if (key == "id") {
+            haveId = true;
+            if (!number || !isInteger(v.number)) return typeError(key, "an integer");
+            spec.id = static_cast<int>(v.number);
+        } else if (key == "name") {
+            if (v.kind != FlatValue::STRING) return typeError(key, "a string");
+            spec.name = v.text;
+            haveName = true;
+        } else if (key == "arrival") {
+            if (!number) return typeError(key, "a number");
+            spec.arrivalTime = v.number;
+        } else if (key == "burst") {
+            haveBurst = true;
+            if (!number) return typeError(key, "a number");
+            spec.burstTime = v.number;
+        } else if (key == "priority") {
+            if (!number || !isInteger(v.number)) return typeError(key, "an integer");
+            spec.priority = static_cast<int>(v.number);
+        } else {
+            sink.add(line, "unknown field \"" + key + "\"");
+            typesOk = false;
+        }
+    }, syntaxError);
+
+    if (!parsed) {
+        sink.add(line, "syntax error: " + syntaxError);
+        return false;
+    }
+    dependency = haveParent || haveChild;
+    if (dependency) {
+        if (haveProcessField) {
+            sink.add(line, "a line is either a process or a dependency, not both");
+            typesOk = false;
+        } else if (!haveParent || !haveChild) {
+            sink.add(line, haveParent ? "missing \"child\"" : "missing \"parent\"");
+            typesOk = false;
+        }
+        return typesOk;
+    }
+    if (!haveId) {
+        sink.add(line, "missing \"id\"");
+        typesOk = false;
+    }
+    if (!haveBurst) {
+        sink.add(line, "missing \"burst\"");
+        typesOk = false;
+    }
+    if (typesOk && !haveName) {
+        spec.name = "P" + std::to_string(spec.id);
+    }
+    return typesOk;
+}
+
+/**
+ * Header line: format marker, version and optional config
+ * Returns false when the rest of the file cannot be interpreted
+ */
+bool parseHeaderLine(const char* begin, const char* end, int line, Scenario& out, ErrorSink& sink) {
+    nlohmann::json header = nlohmann::json::parse(begin, end, nullptr, false);
+    if (header.is_discarded() || !header.is_object() ||
+        header.value("format", std::string()) != SCENARIO_FORMAT) {
+        sink.add(line, std::string("expected a header object with \"format\": \"") +
+                       SCENARIO_FORMAT + "\"");
+        return false;
+    }
+
+    const nlohmann::json& version = header["version"];
+    if (!version.is_number_integer() || version.get<int>() < 1 || version.get<int>() > SCENARIO_VERSION) {
+        sink.add(line, "unsupported version " + version.dump() + " (this build reads 1.." +
+                       std::to_string(SCENARIO_VERSION) + ")");
+        return false;
+    }
+    out.version = version.get<int>();
+
+    for (auto it = header.begin(); it != header.end(); ++it) {
+        if (it.key() != "format" && it.key() != "version" && it.key() != "config") {
+            sink.add(line, "unknown header field \"" + it.key() + "\"");
+        }
+    }
+
+    if (!header.contains("config")) return true;
+    const nlohmann::json& config = header["config"];
+    if (!config.is_object()) {
+        sink.add(line, "\"config\" must be an object");
+        return true;
+    }
+
+    for (auto it = config.begin(); it != config.end(); ++it) {
+        const std::string& key = it.key();
+        const nlohmann::json& v = it.value();
+        bool ok = true;
+        if (key == "algorithm") {
+            ok = v.is_string();
+            if (ok) out.config.algorithm = v.get<std::string>();
+        } else if (key == "quantum") {
+            ok = v.is_number();
+            if (ok) out.config.timeQuantum = v.get<double>();
+        } else if (key == "aging") {
+            ok = v.is_boolean();
+            if (ok) out.config.agingEnabled = v.get<bool>();
+        } else if (key == "aging_threshold") {
+            ok = v.is_number();
+            if (ok) out.config.agingThreshold = v.get<double>();
+        } else if (key == "aging_boost") {
+            ok = v.is_number_integer();
+            if (ok) out.config.agingBoostAmount = v.get<int>();
+        } else if (key == "time_resolution") {
+            ok = v.is_number_integer();
+            if (ok) out.timeResolution = v.get<SimTime>();
+        } else if (key == "context_switch") {
+            ok = v.is_number();
+            if (ok) out.contextSwitchCost = v.get<double>();
+        } else {
+            sink.add(line, "unknown config field \"" + key + "\"");
+            continue;
+        }
+        if (!ok) sink.add(line, "config field \"" + key + "\" has the wrong type");
+    }
+    validateConfig(out, line, sink);
+    return true;
+}
+
+// === Binary encoding ===
+
+void putBytes(std::string& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out += static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+}
+
+void putF64(std::string& out, double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    putBytes(out, bits, 8);
+}
+
+/**
+ * Bounds-checked little-endian reader; 'ok' turns false on truncation
+ */
+class ByteReader {
+public:
+    explicit ByteReader(const std::string& bytes) : data(bytes) {}
+
+    bool ok = true;
+    size_t pos = 0;
+
+    uint64_t get(int bytes) {
+        if (!ok || data.size() - pos < static_cast<size_t>(bytes)) {
+            ok = false;
+            return 0;
+        }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) {
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+        }
+        pos += bytes;
+        return v;
+    }
+
+    double f64() {
+        uint64_t bits = get(8);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+
+    std::string text(size_t n) {
+        if (!ok || data.size() - pos < n) {
+            ok = false;
+            return std::string();
+        }
+        std::string s = data.substr(pos, n);
+        pos += n;
+        return s;
+    }
+
+private:
+    const std::string& data;
+};
+
+std::string formatNumber(double v) {
+    if (isInteger(v)) return std::to_string(static_cast<long long>(v));
+    return nlohmann::json(v).dump();
+}
+
+}
+
+bool parseScenario(const std::string& text, Scenario& out, std::vector<ScenarioError>& errors) {
+    out = Scenario();
+    ErrorSink sink(errors);
+    std::unordered_map<int, int> firstLine;
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    int line = 0;
+    bool haveHeader = false;
+    ProcessSpec spec;
+    DependencySpec edge;
+    bool dependency = false;
+    std::vector<int> edgeLines;
+
+    size_t lines = std::count(text.begin(), text.end(), '\n') + 1;
+    out.processes.reserve(lines);
+    firstLine.reserve(lines);
+
+    while (p < end) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* lineEnd = newline ? newline : end;
+        const char* begin = p;
+        p = newline ? newline + 1 : end;
+        line++;
+
+        while (begin < lineEnd && (*begin == ' ' || *begin == '\t')) ++begin;
+        const char* trimmed = lineEnd;
+        while (trimmed > begin && (trimmed[-1] == '\r' || trimmed[-1] == ' ' || trimmed[-1] == '\t')) --trimmed;
+        if (begin == trimmed || *begin == '#') continue;
+
+        if (!haveHeader) {
+            haveHeader = true;
+            if (!parseHeaderLine(begin, trimmed, line, out, sink)) break;
+            continue;
+        }
+
+        if (!parseProcessLine(begin, trimmed, line, spec, edge, dependency, sink)) continue;
+        if (dependency) {
+            if (out.version < 2) sink.add(line, "dependencies need version 2");
+            out.dependencies.push_back(edge);
+            edgeLines.push_back(line);
+        } else {
+            validateProcess(spec, line, sink, firstLine, out.timeResolution);
+            out.processes.push_back(std::move(spec));
+        }
+    }
+
+    if (!haveHeader) {
+        sink.add(0, "missing header line");
+    }
+    validateDependencies(out.dependencies, edgeLines, sink, firstLine);
+    return sink.finish();
+}
+
+bool parseScenarioBinary(const std::string& bytes, Scenario& out, std::vector<ScenarioError>& errors) {
+    out = Scenario();
+    ErrorSink sink(errors);
+    ByteReader in(bytes);
+
+    if (in.text(4) != std::string(BINARY_MAGIC, 4)) {
+        sink.add(0, "not a binary scenario (bad magic)");
+        return sink.finish();
+    }
+    out.version = static_cast<int>(in.get(4));
+    if (in.ok && (out.version < 1 || out.version > SCENARIO_VERSION)) {
+        sink.add(0, "unsupported version " + std::to_string(out.version));
+        return sink.finish();
+    }
+
+    out.config.algorithm = in.text(in.get(1));
+    out.config.timeQuantum = in.f64();
+    out.config.agingEnabled = in.get(1) != 0;
+    out.config.agingThreshold = in.f64();
+    out.config.agingBoostAmount = static_cast<int32_t>(in.get(4));
+    out.timeResolution = static_cast<int64_t>(in.get(8));
+    out.contextSwitchCost = in.f64();
+    uint32_t count = static_cast<uint32_t>(in.get(4));
+    if (!in.ok) {
+        sink.add(0, "truncated header");
+        return sink.finish();
+    }
+    validateConfig(out, 0, sink);
+
+    // Every record is at least 26 bytes; don't trust 'count' for the reservation
+    out.processes.reserve(std::min<size_t>(count, (bytes.size() - in.pos) / 26));
+    std::unordered_map<int, int> firstLine;
+    for (uint32_t i = 0; i < count; ++i) {
+        int record = static_cast<int>(i) + 1;
+        ProcessSpec spec;
+        spec.id = static_cast<int32_t>(in.get(4));
+        spec.arrivalTime = in.f64();
+        spec.burstTime = in.f64();
+        spec.priority = static_cast<int32_t>(in.get(4));
+        spec.name = in.text(in.get(2));
+        if (!in.ok) {
+            sink.add(record, "truncated record at byte " + std::to_string(in.pos));
+            break;
+        }
+        validateProcess(spec, record, sink, firstLine, out.timeResolution);
+        out.processes.push_back(std::move(spec));
+    }
+    if (in.ok && out.version >= 2) {
+        uint32_t edges = static_cast<uint32_t>(in.get(4));
+        out.dependencies.reserve(std::min<size_t>(edges, (bytes.size() - in.pos) / 8));
+        std::vector<int> edgeRecords;
+        for (uint32_t i = 0; i < edges && in.ok; ++i) {
+            DependencySpec edge;
+            edge.parent = static_cast<int32_t>(in.get(4));
+            edge.child = static_cast<int32_t>(in.get(4));
+            if (!in.ok) break;
+            out.dependencies.push_back(edge);
+            edgeRecords.push_back(static_cast<int>(count + i) + 1);
+        }
+        if (!in.ok) sink.add(0, "truncated dependency at byte " + std::to_string(in.pos));
+        validateDependencies(out.dependencies, edgeRecords, sink, firstLine);
+    }
+    if (in.ok && in.pos != bytes.size()) {
+        sink.add(0, std::to_string(bytes.size() - in.pos) + " trailing byte(s)");
+    }
+    return sink.finish();
+}
+
+bool loadScenarioFile(const std::string& path, Scenario& out, std::vector<ScenarioError>& errors) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        errors.push_back({0, "cannot open " + path});
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.compare(0, 4, BINARY_MAGIC, 4) == 0) {
+        return parseScenarioBinary(bytes, out, errors);
+    }
+    return parseScenario(bytes, out, errors);
+}
+
+std::string formatScenario(const Scenario& s) {
+    // ordered_json keeps "format" first, as in the documented layout
+    nlohmann::ordered_json header = {
+        {"format", SCENARIO_FORMAT},
+        {"version", s.dependencies.empty() ? 1 : SCENARIO_VERSION},
+        {"config", {
+            {"algorithm", s.config.algorithm},
+            {"quantum", s.config.timeQuantum},
+            {"aging", s.config.agingEnabled},
+            {"aging_threshold", s.config.agingThreshold},
+            {"aging_boost", s.config.agingBoostAmount},
+            {"time_resolution", s.timeResolution},
+            {"context_switch", s.contextSwitchCost}
+        }}
+    };
+
+    std::string out = header.dump() + "\n";
+    out.reserve(out.size() + s.processes.size() * 64);
+    for (const auto& p : s.processes) {
+        out += "{\"id\":" + std::to_string(p.id);
+        out += ",\"name\":" + nlohmann::json(p.name).dump();
+        out += ",\"arrival\":" + formatNumber(p.arrivalTime);
+        out += ",\"burst\":" + formatNumber(p.burstTime);
+        out += ",\"priority\":" + std::to_string(p.priority) + "}\n";
+    }
+    for (const auto& d : s.dependencies) {
+        out += "{\"parent\":" + std::to_string(d.parent) + ",\"child\":" + std::to_string(d.child) + "}\n";
+    }
+    return out;
+}
+
+std::string formatScenarioBinary(const Scenario& s) {
+    std::string out(BINARY_MAGIC, 4);
+    putBytes(out, s.dependencies.empty() ? 1 : SCENARIO_VERSION, 4);
+    std::string algo = s.config.algorithm.substr(0, 255);
+    putBytes(out, algo.size(), 1);
+    out += algo;
+    putF64(out, s.config.timeQuantum);
+    putBytes(out, s.config.agingEnabled ? 1 : 0, 1);
+    putF64(out, s.config.agingThreshold);
+    putBytes(out, static_cast<uint32_t>(s.config.agingBoostAmount), 4);
+    putBytes(out, static_cast<uint64_t>(s.timeResolution), 8);
+    putF64(out, s.contextSwitchCost);
+    putBytes(out, s.processes.size(), 4);
+
+    out.reserve(out.size() + s.processes.size() * 32);
+    for (const auto& p : s.processes) {
+        std::string name = p.name.substr(0, 65535);
+        putBytes(out, static_cast<uint32_t>(p.id), 4);
+        putF64(out, p.arrivalTime);
+        putF64(out, p.burstTime);
+        putBytes(out, static_cast<uint32_t>(p.priority), 4);
+        putBytes(out, name.size(), 2);
+        out += name;
+    }
+    if (!s.dependencies.empty()) {
+        putBytes(out, s.dependencies.size(), 4);
+        for (const auto& d : s.dependencies) {
+            putBytes(out, static_cast<uint32_t>(d.parent), 4);
+            putBytes(out, static_cast<uint32_t>(d.child), 4);
+        }
+    }
+    return out;
+}
+
+bool isKnownAlgorithm(const std::string& algorithm) {
+    for (const char* known : KNOWN_ALGORITHMS) {
+        if (algorithm == known) return true;
+    }
+    return false;
+}
+
+bool fitsSimTime(double value, SimTime timeResolution) {
+    // 2^63: doubles at or past it don't convert to int64_t
+    double base = value * static_cast<double>(timeResolution);
+    return std::isfinite(base) && std::fabs(base) < 9223372036854775808.0;
+}
+
+void applyScenario(const Scenario& s, Scheduler& scheduler) {
+    scheduler.setTimeResolution(s.timeResolution);
+    scheduler.setContextSwitchCost(s.contextSwitchCost);
+    scheduler.setAlgorithm(s.config.algorithm);
+    scheduler.setTimeQuantum(s.config.timeQuantum);
+    scheduler.setAging(s.config.agingEnabled);
+    scheduler.setAgingThreshold(s.config.agingThreshold);
+    scheduler.setAgingBoostAmount(s.config.agingBoostAmount);
+    for (const auto& p : s.processes) {
+        scheduler.addProcess(p.id, p.name, p.arrivalTime, p.burstTime, p.priority);
+    }
+    for (const auto& d : s.dependencies) {
+        scheduler.addDependency(d.parent, d.child);
+    }
+}
+
+nlohmann::json parseScenarioJSON(const std::string& text) {
+    Scenario s;
+    std::vector<ScenarioError> errors;
+    bool ok = parseScenario(text, s, errors);
+
+    nlohmann::json out;
+    out["ok"] = ok;
+    out["errors"] = nlohmann::json::array();
+    for (const auto& e : errors) {
+        out["errors"].push_back({{"line", e.line}, {"message", e.message}});
+    }
+    out["config"] = {
+        {"algorithm", s.config.algorithm},
+        {"quantum", s.config.timeQuantum},
+        {"aging", s.config.agingEnabled},
+        {"aging_threshold", s.config.agingThreshold},
+        {"aging_boost", s.config.agingBoostAmount},
+        {"time_resolution", s.timeResolution},
+        {"context_switch", s.contextSwitchCost}
+    };
+    out["processes"] = nlohmann::json::array();
+    for (const auto& p : s.processes) {
+        out["processes"].push_back({
+            {"id", p.id},
+            {"name", p.name},
+            {"arrival", p.arrivalTime},
+            {"burst", p.burstTime},
+            {"priority", p.priority}
+        });
+    }
+    out["dependencies"] = nlohmann::json::array();
+    for (const auto& d : s.dependencies) {
+        out["dependencies"].push_back({{"parent", d.parent}, {"child", d.child}});
+    }
+    return out;
+}
@@ -1,313 +1,2463 @@
 #include "scheduler.h"
+#include "policy_plugin.h"
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
 
 Scheduler::Scheduler() {
     currentTime = 0;
     currentQuantumUsed = 0;
+    resetCores();
 }
 
-void Scheduler::addProcess(int id, std::string name, int arrivalTime, int burstTime, int priority) {
+/**
+ * Change the resolution and rederive every time-valued setting from the value
+ * it was configured with, so a quantum of 2 stays 2 time units
+ */
+void Scheduler::setTimeResolution(SimTime unitsPerTime) {
+    timeResolution = std::max<SimTime>(1, unitsPerTime);
+    timeQuantum = toBase(quantumUnits);
+    agingThreshold = toBase(agingThresholdUnits);
+    contextSwitchCost = std::max<SimTime>(0, toBase(contextSwitchUnits));
+    initialBurstGuess = std::max<SimTime>(1, toBase(initialGuessUnits));
+    for (auto& qc : queueClasses) {
+        qc.timeQuantum = toBase(qc.quantumUnits);
+        qc.timeSlice = std::max<SimTime>(1, toBase(qc.sliceUnits));
+    }
+    tableStale = true;
+    stateVersion++;
+}
+
+void Scheduler::setContextSwitchCost(double cost) {
+    contextSwitchUnits = cost;
+    contextSwitchCost = std::max<SimTime>(0, toBase(cost));
+}
+
+bool Scheduler::addProcess(int id, std::string name, double arrivalTime, double burstTime, int priority) {
+    if (id < 0 || slotOfId.count(id)) return false;
+    
     Process p;
     p.id = id;
     p.name = name;
-    p.arrivalTime = arrivalTime;
-    p.burstTime = burstTime;
+    p.arrivalTime = toBase(arrivalTime);
+    p.burstTime = toBase(burstTime);
     p.priority = priority;
     p.originalPriority = priority;  // Store original for reference
-    p.remainingTime = burstTime;
+    p.remainingTime = p.burstTime;
     p.startTime = -1;
     p.responseTime = -1;
+    p.slot = static_cast<int>(table.ids.size());
+    
+    table.ids.push_back(id);
+    table.state.push_back(ProcessTable::NOT_ARRIVED);
+    table.remaining.push_back(0);
+    table.priority.push_back(priority);
+    table.waiting.push_back(0);
+    table.turnaround.push_back(0);
+    table.response.push_back(0);
+    table.readyOrder.push_back(-1);
+    
+    slotOfId[id] = p.slot;
+    slotWhere.push_back(ProcessTable::NOT_ARRIVED);
+    slotContainer.push_back(-1);
+    slotPos.push_back(0);
+    auto interned = nameIds.emplace(p.name, static_cast<int>(idsByName.size()));
+    if (interned.second) idsByName.emplace_back();
+    idsByName[interned.first->second].push_back(id);
+    
+    hashEvent(id);
+    hashEvent(p.arrivalTime);
+    hashEvent(p.burstTime);
+    hashEvent(priority);
+    
+    if (!dagNodes.empty()) {
+        dagNodes.emplace_back();
+        dagNodes.back().arrival = p.arrivalTime;
+        dagNodes.back().burst = p.burstTime;
+    }
+    addToPool(std::move(p));
+    tableStale = true;
+    stateVersion++;
+    return true;
+}
+
+void Scheduler::setAlgorithm(std::string algo) {
+    algorithm = algo;
+    exprHeapSize = 0;
+    resetRatioHeap();
+    
+    // MLQ without explicit classes behaves as a single FCFS class
+    if (algorithm == "MLQ" && queueClasses.empty()) {
+        QueueClass qc;
+        qc.quantumUnits = quantumUnits;
+        qc.timeQuantum = timeQuantum;
+        queueClasses.push_back(qc);
+        implicitClass = true;
+    }
+}
+
+std::string Scheduler::setPriorityExpression(const std::string& text) {
+    std::string error;
+    if (!priorityExpr.compile(text, error)) return error;
+    exprHeapSize = 0;
+    return "";
+}
+
+void Scheduler::setTimeQuantum(double q) {
+    quantumUnits = q;
+    timeQuantum = toBase(q);
+}
+
+void Scheduler::setAging(bool enabled) {
+    agingEnabled = enabled;
+}
+
+void Scheduler::setAgingThreshold(double threshold) {
+    agingThresholdUnits = threshold;
+    agingThreshold = toBase(threshold);
+}
+
+void Scheduler::setAgingBoostAmount(int amount) {
+    agingBoostAmount = amount;
+}
+
+int Scheduler::addQueueClass(std::string algo, double quantum, double timeSlice) {
+    // The first explicit class replaces the default one setAlgorithm("MLQ") added
+    if (implicitClass && queueClasses.size() == 1 && queueClasses[0].readyQueue.empty()) {
+        queueClasses.clear();
+    }
+    implicitClass = false;
+    
+    QueueClass qc;
+    qc.algorithm = algo;
+    qc.quantumUnits = quantum;
+    qc.sliceUnits = timeSlice;
+    qc.timeQuantum = toBase(quantum);
+    qc.timeSlice = std::max<SimTime>(1, toBase(timeSlice));
+    queueClasses.push_back(qc);
+    return static_cast<int>(queueClasses.size()) - 1;
+}
+
+void Scheduler::setInterQueuePolicy(std::string policy) {
+    interQueuePolicy = policy;
+}
+
+void Scheduler::setProcessClass(int id, int queueClass) {
+    Process* p = findProcess(id);
+    if (p && slotWhere[p->slot] == ProcessTable::NOT_ARRIVED) p->queueClass = queueClass;
+}
+
+void Scheduler::addLockRequest(int processId, int lockId, double acquireAt, double releaseAt) {
+    SimTime acquire = toBase(acquireAt);
+    SimTime release = toBase(releaseAt);
+    if (acquire < 0 || release <= acquire) return;
+    
+    Process* p = findProcess(processId);
+    if (p && slotWhere[p->slot] == ProcessTable::NOT_ARRIVED) {
+        // Locks are not recursive: overlapping requests for one lock are ignored
+        release = std::min(release, p->burstTime);
+        for (const auto& req : p->lockRequests) {
+            if (req.lockId == lockId && acquire < req.releaseAt && req.acquireAt < release) return;
+        }
+        p->lockRequests.push_back({lockId, acquire, release});
+        SimLock& lock = locks[lockId];
+        lock.ceiling = std::min(lock.ceiling, p->priority);
+    }
+}
+
+void Scheduler::setLockProtocol(std::string protocol) {
+    lockProtocol = protocol;
+}
+
+void Scheduler::setCoreCount(int cores) {
+    coreCount = std::max(1, cores);
+    resetCores();
+}
+
+void Scheduler::setProcessThreads(int id, int threads) {
+    Process* p = findProcess(id);
+    if (p && slotWhere[p->slot] == ProcessTable::NOT_ARRIVED) p->threadCount = std::max(1, threads);
+}
+
+bool Scheduler::addDependency(int parentId, int childId) {
+    auto parent = slotOfId.find(parentId);
+    auto child = slotOfId.find(childId);
+    if (parent == slotOfId.end() || child == slotOfId.end() || parent->second >= child->second) return false;
+    const Process* p = locate(parent->second);
+    Process* c = const_cast<Process*>(locate(child->second));
+    if (!p || !c || slotWhere[child->second] != ProcessTable::NOT_ARRIVED) return false;
+    
+    if (dagNodes.empty()) {
+        dagNodes.resize(table.ids.size());
+        for (size_t slot = 0; slot < dagNodes.size(); ++slot) {
+            const Process* q = locate(static_cast<int>(slot));
+            dagNodes[slot].arrival = q ? q->arrivalTime : 0;
+            dagNodes[slot].burst = q ? q->burstTime : 0;
+        }
+    }
+    
+    DagNode& node = dagNodes[child->second];
+    dagNodes[parent->second].children.push_back(child->second);
+    if (slotWhere[parent->second] == ProcessTable::FINISHED) {
+        node.releaseTime = std::max(node.releaseTime, p->completionTime);
+        c->arrivalTime = std::max(c->arrivalTime, p->completionTime);
+    } else {
+        node.pendingParents++;
+        dagChanged = true;
+    }
+    
+    hashEvent(parentId);
+    hashEvent(childId);
+    tableStale = true;
+    stateVersion++;
+    return true;
+}
+
+void Scheduler::setDVFS(bool enabled) {
+    dvfsEnabled = enabled;
+}
+
+void Scheduler::addFrequencyState(int mhz, double voltage) {
+    if (mhz <= 0) return;
+    frequencyStates.push_back({mhz, voltage});
+    std::sort(frequencyStates.begin(), frequencyStates.end(),
+        [](const FrequencyState& a, const FrequencyState& b){ return a.mhz < b.mhz; });
+}
+
+void Scheduler::setGovernor(std::string g) {
+    governor = g;
+}
+
+void Scheduler::setPowerModel(double staticWatts, double cap) {
+    staticPower = staticWatts;
+    capacitance = cap;
+}
+
+void Scheduler::setReferenceFrequency(int mhz) {
+    referenceMHz = mhz;
+}
+
+void Scheduler::setBurstPredictor(std::string predictor, double param) {
+    burstPredictor = predictor == "EWMA" || predictor == "Quantile" ? predictor : "None";
+    predictorParam = param > 0 && param <= 1 ? param : 0.5;
+}
+
+void Scheduler::setInitialBurstGuess(double guess) {
+    initialGuessUnits = guess;
+    initialBurstGuess = std::max<SimTime>(1, toBase(guess));
+}
+
+void Scheduler::setPolicy(std::shared_ptr<PolicyInstance> p) {
+    policy = p;
+    policyRule = policy ? std::string("plugin:") + policy->table.name : "";
+    policyRuleName = nullptr;
+    algorithm = policy ? "Plugin" : "FCFS";
+}
+
+bool Scheduler::isFinished() const {
+    if (deadlocked) return true;
+    return jobPool.empty() && readyQueue.empty() && cpu.empty() && highestReadyClass() == -1
+        && blockedCount == 0 && gangRunning.empty() && heldProcesses.empty();
+}
+
+/**
+ * Resolve the ready queue a process belongs to
+ * Outside MLQ this is always readyQueue; class indices are clamped to the configured
+ * range (setAlgorithm("MLQ") guarantees at least one class)
+ */
+int Scheduler::readyClassOf(const Process& p) const {
+    if (algorithm != "MLQ" || queueClasses.empty()) return -1;
+    return std::min(std::max(0, p.queueClass), static_cast<int>(queueClasses.size()) - 1);
+}
+
+std::vector<Process>& Scheduler::readyQueueFor(const Process& p) {
+    int cls = readyClassOf(p);
+    return cls < 0 ? readyQueue : queueClasses[cls].readyQueue;
+}
+
+void Scheduler::pushReady(Process p) {
+    int cls = readyClassOf(p);
+    std::vector<Process>& queue = cls < 0 ? readyQueue : queueClasses[cls].readyQueue;
+    track(p, ProcessTable::READY, cls, queue.size());
+    queue.push_back(std::move(p));
+}
+
+int Scheduler::highestReadyClass() const {
+    for (size_t i = 0; i < queueClasses.size(); ++i) {
+        if (!queueClasses[i].readyQueue.empty()) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int Scheduler::nextReadyClass(int from) const {
+    int n = static_cast<int>(queueClasses.size());
+    for (int step = 1; step <= n; ++step) {
+        int cls = (from + step) % n;
+        if (!queueClasses[cls].readyQueue.empty()) return cls;
+    }
+    return -1;
+}
+
+/**
+ * Check for process arrivals and move them to ready queue
+ * Processes are added in arrival order (FIFO within same arrival time), then
+ * DAG children released by the previous tick's completions in release order
+ * Only the processes that arrive are visited
+ */
+void Scheduler::checkArrivals() {
+    if (dagChanged) holdDependents();
+    
+    while (!arrivalHeap.empty() && arrivalHeap.front().first <= currentTime) {
+        int32_t slot = arrivalHeap.front().second;
+        std::pop_heap(arrivalHeap.begin(), arrivalHeap.end(), std::greater<std::pair<SimTime, int32_t>>());
+        arrivalHeap.pop_back();
+        
+        size_t pos = slotPos[slot];
+        if (slotWhere[slot] != ProcessTable::NOT_ARRIVED || slotContainer[slot] != -1 ||
+            pos >= jobPool.size() || jobPool[pos].slot != slot) {
+            continue;  // Left jobPool since this entry was pushed
+        }
+        Process& p = jobPool[pos];
+        if (p.arrivalTime > currentTime) continue;  // Held and released again with a later arrival
+        hashEvent(p.id);
+        if (burstPredictor != "None") p.predictedBurst = predictBurst(p.name);
+        pushReady(std::move(p));
+        swapRemove(jobPool, pos);
+    }
+    
+    for (int32_t slot : releasedSlots) {
+        if (dagNodes[slot].pendingParents > 0) continue;  // Gained a parent since its release
+        size_t pos = slotPos[slot];
+        Process& p = heldProcesses[pos];
+        hashEvent(p.id);
+        if (burstPredictor != "None") p.predictedBurst = predictBurst(p.name);
+        pushReady(std::move(p));
+        swapRemove(heldProcesses, pos);
+    }
+    releasedSlots.clear();
+}
+
+void Scheduler::addToPool(Process p) {
+    track(p, ProcessTable::NOT_ARRIVED, -1, jobPool.size());
+    arrivalHeap.emplace_back(std::max(p.arrivalTime, currentTime), p.slot);
+    std::push_heap(arrivalHeap.begin(), arrivalHeap.end(), std::greater<std::pair<SimTime, int32_t>>());
+    jobPool.push_back(std::move(p));
+}
+
+void Scheduler::swapRemove(std::vector<Process>& queue, size_t pos) {
+    if (pos + 1 != queue.size()) {
+        queue[pos] = std::move(queue.back());
+        slotPos[queue[pos].slot] = static_cast<uint32_t>(pos);
+    }
+    queue.pop_back();
+}
+
+std::vector<const Process*> Scheduler::jobPoolInOrder() const {
+    std::vector<const Process*> ordered;
+    ordered.reserve(jobPool.size());
+    for (const auto& p : jobPool) ordered.push_back(&p);
+    std::sort(ordered.begin(), ordered.end(), [](const Process* a, const Process* b) { return a->slot < b->slot; });
+    return ordered;
+}
+
+/**
+ * Park jobPool processes that gained unfinished parents since the last tick
+ */
+void Scheduler::holdDependents() {
+    dagChanged = false;
+    for (size_t i = 0; i < jobPool.size();) {
+        Process& p = jobPool[i];
+        if (dagNodes[p.slot].pendingParents == 0) {
+            ++i;
+            continue;
+        }
+        track(p, ProcessTable::NOT_ARRIVED, -3, heldProcesses.size());
+        heldProcesses.push_back(std::move(p));
+        swapRemove(jobPool, i);
+    }
+}
+
+/**
+ * Count down the in-degree of every child of a finished process
+ * A child whose last parent just finished arrives next tick, unless its own
+ * arrival time is later, in which case it goes back to jobPool until then
+ */
+void Scheduler::releaseDependents(const Process& p) {
+    if (dagNodes.empty()) return;
+    for (int32_t child : dagNodes[p.slot].children) {
+        DagNode& node = dagNodes[child];
+        node.releaseTime = std::max(node.releaseTime, p.completionTime);
+        if (--node.pendingParents > 0) continue;
+        
+        size_t pos = slotPos[child];
+        Process& c = heldProcesses[pos];
+        c.arrivalTime = std::max(node.arrival, node.releaseTime);
+        if (c.arrivalTime <= p.completionTime) {
+            releasedSlots.push_back(child);
+        } else {
+            addToPool(std::move(c));
+            swapRemove(heldProcesses, pos);
+        }
+    }
+}
+
+/**
+ * Earliest and latest starts over the DAG in two sweeps over the slots:
+ * parents always have lower slots, so a forward sweep sees every parent's
+ * earliest finish before its children and a backward sweep every child's
+ * latest start before its parents
+ */
+DagMetrics Scheduler::getDagMetrics() const {
+    static const std::vector<int32_t> NO_CHILDREN;
+    size_t n = table.ids.size();
+    std::vector<SimTime> earliest(n), burst(n);
+    for (size_t slot = 0; slot < n; ++slot) {
+        if (!dagNodes.empty()) {
+            earliest[slot] = dagNodes[slot].arrival;
+            burst[slot] = dagNodes[slot].burst;
+        } else if (const Process* p = locate(static_cast<int>(slot))) {
+            earliest[slot] = p->arrivalTime;
+            burst[slot] = p->burstTime;
+        }
+    }
+    auto children = [this](size_t slot) -> const std::vector<int32_t>& {
+        return dagNodes.empty() ? NO_CHILDREN : dagNodes[slot].children;
+    };
+    
+    SimTime path = 0, work = 0;
+    for (size_t slot = 0; slot < n; ++slot) {
+        SimTime finish = earliest[slot] + burst[slot];
+        path = std::max(path, finish);
+        work += burst[slot];
+        for (int32_t child : children(slot)) {
+            earliest[child] = std::max(earliest[child], finish);
+        }
+    }
+    
+    DagMetrics m;
+    double unit = static_cast<double>(timeResolution);
+    std::vector<SimTime> latest(n);
+    m.slack.resize(n);
+    for (size_t slot = n; slot-- > 0;) {
+        SimTime finishBy = path;
+        for (int32_t child : children(slot)) {
+            finishBy = std::min(finishBy, latest[child]);
+        }
+        latest[slot] = finishBy - burst[slot];
+        m.slack[slot] = (latest[slot] - earliest[slot]) / unit;
+    }
+    for (size_t slot = 0; slot < n; ++slot) {
+        if (latest[slot] == earliest[slot]) m.criticalIds.push_back(table.ids[slot]);
+        if (!dagNodes.empty() && dagNodes[slot].pendingParents > 0) m.held++;
+    }
+    
+    SimTime makespan = 0;
+    for (const auto& p : finishedProcesses) {
+        makespan = std::max(makespan, p.completionTime);
+    }
+    m.criticalPath = path / unit;
+    m.work = work / unit;
+    m.makespan = makespan / unit;
+    return m;
+}
+
+/**
+ * Preempt the currently running process
+ * Moves CPU process back to ready queue
+ */
+void Scheduler::preemptCPU() {
+    if (!cpu.empty()) {
+        Process p = cpu.front();
+        cpu.clear();
+        pushReady(std::move(p));
+        currentQuantumUsed = 0;
+        switchRemaining = 0;
+    }
+}
+
+namespace {
+
+const SimTime RATIO_NEVER = INT64_MAX;
+
+/**
+ * HRRN order 'ahead' waiting ticks from now: higher (waiting + remaining) / remaining
+ * first, then earlier arrival, then lower id. Ratios are compared cross-multiplied,
+ * which is exact while the products stay below 2^53
+ */
+bool ratioBefore(const Process& a, const Process& b, SimTime ahead = 0) {
+    double lhs = static_cast<double>(a.waitingTime + ahead + a.remainingTime) * static_cast<double>(b.remainingTime);
+    double rhs = static_cast<double>(b.waitingTime + ahead + b.remainingTime) * static_cast<double>(a.remainingTime);
+    if (lhs != rhs) return lhs > rhs;
+    if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+    return a.id < b.id;
+}
+
+// Strictly higher ratio, ignoring ties: the HRRNP preemption rule
+bool ratioAbove(const Process& a, const Process& b) {
+    return static_cast<double>(a.waitingTime + a.remainingTime) * static_cast<double>(b.remainingTime) >
+           static_cast<double>(b.waitingTime + b.remainingTime) * static_cast<double>(a.remainingTime);
+}
+
+/**
+ * Waiting ticks from now until 'child' overtakes 'parent' (both keep waiting), RATIO_NEVER if it never does
+ * The gap is linear in the ticks waited, so the estimate is corrected by at most a step or two
+ */
+SimTime ticksUntilOvertake(const Process& child, const Process& parent) {
+    if (ratioBefore(child, parent)) return 0;
+    // Only a shorter remaining time gains ratio faster
+    if (child.remainingTime >= parent.remainingTime) return RATIO_NEVER;
+    
+    double gap = static_cast<double>(parent.waitingTime + parent.remainingTime) * child.remainingTime -
+                 static_cast<double>(child.waitingTime + child.remainingTime) * parent.remainingTime;
+    double estimate = std::floor(gap / static_cast<double>(parent.remainingTime - child.remainingTime));
+    if (!(estimate < 4e18)) return RATIO_NEVER;
+    SimTime ahead = std::max<SimTime>(0, static_cast<SimTime>(estimate));
+    while (!ratioBefore(child, parent, ahead)) ahead++;
+    while (ahead > 0 && ratioBefore(child, parent, ahead - 1)) ahead--;
+    return ahead;
+}
+
+}
+
+// Sorting helpers
+void Scheduler::sortBySJF(std::vector<Process>& queue) {
+    std::sort(queue.begin(), queue.end(), [this](const Process& a, const Process& b){
+        SimTime ka = visibleBurst(a), kb = visibleBurst(b);
+        if (ka != kb) return ka < kb;
+        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+        return a.id < b.id;
+    });
+}
+
+void Scheduler::sortBySRTF(std::vector<Process>& queue) {
+    std::sort(queue.begin(), queue.end(), [this](const Process& a, const Process& b){
+        SimTime ka = visibleRemaining(a), kb = visibleRemaining(b);
+        if (ka != kb) return ka < kb;
+        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+        return a.id < b.id;
+    });
+}
+
+void Scheduler::sortByPriority(std::vector<Process>& queue) {
+    std::sort(queue.begin(), queue.end(), [](const Process& a, const Process& b){
+        if (a.priority != b.priority) return a.priority < b.priority;
+        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+        return a.id < b.id;
+    });
+}
+
+void Scheduler::sortByResponseRatio(std::vector<Process>& queue) {
+    std::sort(queue.begin(), queue.end(), [](const Process& a, const Process& b){
+        return ratioBefore(a, b);
+    });
+}
+
+/**
+ * Predicted burst for a process named 'name' arriving now
+ */
+SimTime Scheduler::predictBurst(const std::string& name) const {
+    auto found = burstHistory.find(name);
+    const BurstHistory& history = found != burstHistory.end() ? found->second : allBursts;
+    if (history.count == 0) return initialBurstGuess;
+    
+    if (burstPredictor == "Quantile") {
+        // Nearest rank over the window
+        std::vector<SimTime> window = history.recent;
+        size_t rank = static_cast<size_t>(std::ceil(predictorParam * window.size())) - 1;
+        std::nth_element(window.begin(), window.begin() + rank, window.end());
+        return window[rank];
+    }
+    return std::max<SimTime>(1, std::llround(history.average));
+}
+
+/**
+ * Fold a finished process's true burst into its name's history and the prediction error
+ */
+void Scheduler::observeBurst(const Process& p) {
+    auto record = [this, &p](BurstHistory& history) {
+        double burst = static_cast<double>(p.burstTime);
+        history.average = history.count == 0 ? burst : predictorParam * burst + (1 - predictorParam) * history.average;
+        if (history.recent.size() < BurstHistory::WINDOW) {
+            history.recent.push_back(p.burstTime);
+        } else {
+            history.recent[history.count % BurstHistory::WINDOW] = p.burstTime;
+        }
+        history.count++;
+    };
+    record(burstHistory[p.name]);
+    record(allBursts);
+    
+    if (p.predictedBurst >= 0) {
+        double error = std::fabs(static_cast<double>(p.predictedBurst - p.burstTime));
+        predictionAbsError += error;
+        predictionRelError += error / static_cast<double>(std::max<SimTime>(1, p.burstTime));
+        predictedCount++;
+    }
+}
+
+SimTime Scheduler::visibleBurst(const Process& p) const {
+    return p.predictedBurst < 0 ? p.burstTime : p.predictedBurst;
+}
+
+/**
+ * Predicted burst minus the CPU time used; a process that outlives its prediction
+ * is taken to be about to finish
+ */
+SimTime Scheduler::visibleRemaining(const Process& p) const {
+    if (p.predictedBurst < 0) return p.remainingTime;
+    return std::max<SimTime>(1, p.predictedBurst - (p.burstTime - p.remainingTime));
+}
+
+/**
+ * Check if SRTF preemption should occur
+ * Returns true if a ready process has shorter remaining time than current CPU process
+ */
+bool Scheduler::shouldPreemptSRTF(const std::vector<Process>& queue) {
+    if (cpu.empty() || queue.empty()) return false;
     
-    jobPool.push_back(p);
+    return visibleRemaining(queue[shortestRemainingIndex(queue)]) < visibleRemaining(cpu[0]);
+}
+
+/**
+ * Check if Priority preemption should occur
+ * Returns true if a ready process has higher priority (lower value) than current CPU process
+ */
+bool Scheduler::shouldPreemptPriority(const std::vector<Process>& queue) {
+    if (cpu.empty() || queue.empty()) return false;
+    
+    return queue[highestPriorityIndex(queue)].priority < cpu[0].priority;
+}
+
+/**
+ * Index of the first ready process with the least remaining time
+ */
+size_t Scheduler::shortestRemainingIndex(const std::vector<Process>& queue) const {
+    size_t best = 0;
+    SimTime bestKey = visibleRemaining(queue[0]);
+    for (size_t i = 1; i < queue.size(); ++i) {
+        SimTime key = visibleRemaining(queue[i]);
+        if (key < bestKey) {
+            best = i;
+            bestKey = key;
+        }
+    }
+    return best;
+}
+
+/**
+ * Index of the first ready process with the lowest priority value
+ */
+size_t Scheduler::highestPriorityIndex(const std::vector<Process>& queue) const {
+    size_t best = 0;
+    for (size_t i = 1; i < queue.size(); ++i) {
+        if (queue[i].priority < queue[best].priority) best = i;
+    }
+    return best;
+}
+
+/**
+ * Index of the ready process with the highest response ratio
+ */
+size_t Scheduler::highestRatioIndex(const std::vector<Process>& queue) {
+    size_t best = 0;
+    for (size_t i = 1; i < queue.size(); ++i) {
+        if (ratioBefore(queue[i], queue[best])) best = i;
+    }
+    return best;
+}
+
+/**
+ * Select and dispatch the next process based on the scheduling algorithm
+ */
+void Scheduler::scheduleNextProcess() {
+    if (algorithm == "MLQ") {
+        scheduleMultilevel();
+    } else if (algorithm == "Expr" || algorithm == "ExprP") {
+        dispatchByExpression();
+    } else if (algorithm == "HRRN" || algorithm == "HRRNP") {
+        dispatchByResponseRatio();
+    } else if (algorithm == "Plugin") {
+        if (cpu.empty() && !readyQueue.empty() && policyWants(SCHED_POLICY_HOOK_SELECT)) {
+            size_t chosen = policy->table.select(policy->table.state, &stagePolicyView());
+            if (chosen >= readyQueue.size()) chosen = 0;
+            // Move the choice to the front, the rest keep queue order (dispatchAt renumbers them)
+            std::rotate(readyQueue.begin(), readyQueue.begin() + chosen, readyQueue.begin() + chosen + 1);
+        }
+        dispatchFrom(readyQueue, policyRule);
+    } else {
+        dispatchFrom(readyQueue, algorithm);
+    }
+}
+
+/**
+ * Dispatch the head of 'queue' to an idle CPU using the ordering of 'algo'
+ */
+void Scheduler::dispatchFrom(std::vector<Process>& queue, const std::string& algo) {
+    if (cpu.empty() && !queue.empty()) {
+        // Apply algorithm-specific sorting
+        if (algo == "SJF") {
+            sortBySJF(queue);
+        } else if (algo == "SRTF") {
+            sortBySRTF(queue);
+        } else if (algo == "Priority" || algo == "PriorityNP") {
+            sortByPriority(queue);
+        } else if (algo == "HRRN" || algo == "HRRNP") {
+            sortByResponseRatio(queue);
+        }
+        // FCFS and RR use arrival order (no sorting needed)
+        // Positions shifted by the sort are renumbered when dispatchAt erases the front
+        
+        if (DecisionRecord* record = beginDecision(DecisionRecord::DISPATCH, algo.c_str(), queue.front().id,
+                                                   -1)) {
+            addCandidates(*record, queue);
+        }
+        
+        dispatchAt(queue, 0);
+    }
+}
+
+void Scheduler::dispatchAt(std::vector<Process>& queue, size_t index) {
+    // Dispatch process to CPU
+    track(queue[index], ProcessTable::RUNNING, -1, 0);
+    cpu.push_back(queue[index]);
+    queue.erase(queue.begin() + index);
+    renumber(queue, index);
+    currentQuantumUsed = 0;
+    
+    // Switching to a different process costs CPU time before it runs
+    if (contextSwitchCost > 0 && lastDispatchedId != -1 && lastDispatchedId != cpu[0].id) {
+        switchRemaining = contextSwitchCost;
+    }
+    lastDispatchedId = cpu[0].id;
+    
+    // Record first execution time (for response time calculation)
+    if (cpu[0].startTime == -1) {
+        cpu[0].startTime = currentTime;
+        cpu[0].responseTime = currentTime - cpu[0].arrivalTime;
+    }
+}
+
+namespace {
+
+// (score, arrival, id): the order of the expression policies
+bool scoredBefore(const Process& a, const Process& b) {
+    if (a.score != b.score) return a.score < b.score;
+    if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+    return a.id < b.id;
+}
+
+// Heap comparator: the front of the heap is the first process in scoredBefore order
+bool scoredAfter(const Process& a, const Process& b) {
+    return scoredBefore(b, a);
+}
+
+}
+
+/**
+ * Evaluate the priority expression for one process (times in user units)
+ */
+double Scheduler::scoreOf(const Process& p) const {
+    double unit = static_cast<double>(timeResolution);
+    double fields[PriorityExpr::FIELD_COUNT];
+    fields[PriorityExpr::ID] = p.id;
+    fields[PriorityExpr::PRIORITY] = p.priority;
+    fields[PriorityExpr::ARRIVAL] = p.arrivalTime / unit;
+    fields[PriorityExpr::BURST] = p.burstTime / unit;
+    fields[PriorityExpr::REMAINING] = p.remainingTime / unit;
+    fields[PriorityExpr::EXECUTED] = (p.burstTime - p.remainingTime) / unit;
+    fields[PriorityExpr::WAITING] = p.waitingTime / unit;
+    fields[PriorityExpr::AGE] = (currentTime - p.arrivalTime) / unit;
+    fields[PriorityExpr::NOW] = currentTime / unit;
+    double score = priorityExpr.evaluate(fields);
+    return std::isnan(score) ? HUGE_VAL : score;  // NaN would break the ordering
+}
+
+/**
+ * Best ready process under the priority expression
+ * Time-invariant expressions: score only the processes appended since the last
+ * decision and push them into the heap (O(k log n)); the best is at index 0.
+ * Otherwise every ready process is re-scored and scanned
+ */
+size_t Scheduler::bestByExpression() {
+    size_t n = readyQueue.size();
+    if (priorityExpr.isTimeInvariant()) {
+        if (exprHeapSize > n) exprHeapSize = 0;
+        if (exprHeapSize == 0) {
+            for (auto& p : readyQueue) p.score = scoreOf(p);
+            std::make_heap(readyQueue.begin(), readyQueue.end(), scoredAfter);
+            renumber(readyQueue, 0);
+        } else {
+            for (size_t i = exprHeapSize; i < n; ++i) {
+                readyQueue[i].score = scoreOf(readyQueue[i]);
+                siftExprUp(i);
+            }
+        }
+        exprHeapSize = n;
+        return 0;
+    }
+    
+    size_t best = 0;
+    for (size_t i = 0; i < n; ++i) {
+        readyQueue[i].score = scoreOf(readyQueue[i]);
+        if (scoredBefore(readyQueue[i], readyQueue[best])) best = i;
+    }
+    return best;
+}
+
+/**
+ * Heap sifts through swapReady, so every moved process keeps its exact position
+ */
+void Scheduler::siftExprUp(size_t pos) {
+    for (; pos > 0 && scoredBefore(readyQueue[pos], readyQueue[(pos - 1) / 2]); pos = (pos - 1) / 2) {
+        swapReady(pos, (pos - 1) / 2);
+    }
+}
+
+void Scheduler::siftExprDown(size_t size) {
+    for (size_t pos = 0;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= size) break;
+        if (child + 1 < size && scoredBefore(readyQueue[child + 1], readyQueue[child])) child++;
+        if (!scoredBefore(readyQueue[child], readyQueue[pos])) break;
+        swapReady(pos, child);
+        pos = child;
+    }
+}
+
+void Scheduler::dispatchByExpression() {
+    if (!cpu.empty() || readyQueue.empty()) return;
+    
+    size_t best = bestByExpression();
+    if (DecisionRecord* record = beginDecision(DecisionRecord::DISPATCH, algorithm.c_str(), readyQueue[best].id, -1)) {
+        addCandidate(*record, readyQueue[best]);
+    }
+    if (priorityExpr.isTimeInvariant()) {
+        // Swap the top to the back so taking it off leaves a valid heap
+        best = readyQueue.size() - 1;
+        swapReady(0, best);
+        exprHeapSize--;
+        siftExprDown(best);
+    }
+    dispatchAt(readyQueue, best);
+}
+
+/**
+ * ExprP: preempt when a ready process scores strictly lower than the running one
+ */
+void Scheduler::handleExpressionPreemption(std::stringstream& log) {
+    if (cpu.empty() || readyQueue.empty()) return;
+    
+    const Process& best = readyQueue[bestByExpression()];
+    cpu[0].score = scoreOf(cpu[0]);
+    if (!(best.score < cpu[0].score)) return;
+    
+    log << "Process " << cpu[0].id << " preempted by Process " << best.id
+        << " (score " << best.score << " < " << cpu[0].score << "). ";
+    if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, algorithm.c_str(), best.id, cpu[0].id)) {
+        addCandidate(*record, best);
+        addCandidate(*record, cpu[0]);
+    }
+    preemptCPU();
+}
+
+/**
+ * Drop the kinetic heap; the whole ready queue is pushed back in at the next decision
+ */
+void Scheduler::resetRatioHeap() {
+    ratioHeapSize = 0;
+    ratioCert.clear();
+    ratioEvents.clear();
+}
+
+/**
+ * Recompute the certificate of the edge between heap[pos] and its parent
+ */
+void Scheduler::refreshRatioCert(size_t pos) {
+    if (pos >= ratioHeapSize) return;
+    SimTime cert = RATIO_NEVER;
+    if (pos > 0) {
+        SimTime ahead = ticksUntilOvertake(readyQueue[pos], readyQueue[(pos - 1) / 2]);
+        if (ahead != RATIO_NEVER) cert = waitClock + ahead;
+    }
+    ratioCert[pos] = cert;
+    if (cert != RATIO_NEVER) {
+        ratioEvents.push_back({cert, static_cast<uint32_t>(pos)});
+        std::push_heap(ratioEvents.begin(), ratioEvents.end(), std::greater<std::pair<SimTime, uint32_t>>());
+    }
+}
+
+/**
+ * Swap heap[pos] with its parent; the edges touching either slot get new certificates
+ */
+void Scheduler::swapRatioParent(size_t pos) {
+    size_t parent = (pos - 1) / 2;
+    swapReady(pos, parent);
+    size_t sibling = pos % 2 == 1 ? pos + 1 : pos - 1;
+    for (size_t affected : {parent, pos, sibling, 2 * pos + 1, 2 * pos + 2}) {
+        refreshRatioCert(affected);
+    }
+}
+
+/**
+ * Bring the heap up to waitClock: swap every edge whose certificate has failed,
+ * then push in processes appended since the last decision (arrivals, preemptions)
+ */
+void Scheduler::advanceRatioHeap() {
+    typedef std::pair<SimTime, uint32_t> Event;
+    if (ratioHeapSize > readyQueue.size()) resetRatioHeap();
+    
+    while (!ratioEvents.empty() && ratioEvents.front().first <= waitClock) {
+        Event event = ratioEvents.front();
+        std::pop_heap(ratioEvents.begin(), ratioEvents.end(), std::greater<Event>());
+        ratioEvents.pop_back();
+        size_t pos = event.second;
+        if (pos >= ratioHeapSize || ratioCert[pos] != event.first) continue;  // Stale
+        if (ratioBefore(readyQueue[pos], readyQueue[(pos - 1) / 2])) {
+            swapRatioParent(pos);
+        } else {
+            refreshRatioCert(pos);
+        }
+    }
+    
+    while (ratioHeapSize < readyQueue.size()) {
+        size_t pos = ratioHeapSize++;
+        ratioCert.push_back(RATIO_NEVER);
+        refreshRatioCert(pos);
+        for (; pos > 0 && ratioBefore(readyQueue[pos], readyQueue[(pos - 1) / 2]); pos = (pos - 1) / 2) {
+            swapRatioParent(pos);
+        }
+    }
+    
+    // Superseded certificates pile up in the event heap; compact it now and then
+    if (ratioEvents.size() > 4 * ratioHeapSize + 64) {
+        ratioEvents.clear();
+        for (size_t pos = 1; pos < ratioHeapSize; ++pos) {
+            if (ratioCert[pos] != RATIO_NEVER) ratioEvents.push_back({ratioCert[pos], static_cast<uint32_t>(pos)});
+        }
+        std::make_heap(ratioEvents.begin(), ratioEvents.end(), std::greater<Event>());
+    }
+}
+
+/**
+ * HRRN / HRRNP dispatch: take the heap top, moving the last heap slot into its place
+ */
+void Scheduler::dispatchByResponseRatio() {
+    if (!cpu.empty() || readyQueue.empty()) return;
+    
+    advanceRatioHeap();
+    if (DecisionRecord* record = beginDecision(DecisionRecord::DISPATCH, algorithm.c_str(), readyQueue[0].id, -1)) {
+        addCandidate(*record, readyQueue[0]);
+    }
+    
+    size_t last = --ratioHeapSize;
+    swapReady(0, last);
+    ratioCert.pop_back();
+    refreshRatioCert(1);
+    refreshRatioCert(2);
+    for (size_t pos = 0;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= ratioHeapSize) break;
+        if (child + 1 < ratioHeapSize && ratioBefore(readyQueue[child + 1], readyQueue[child])) child++;
+        if (!ratioBefore(readyQueue[child], readyQueue[pos])) break;
+        swapRatioParent(child);
+        pos = child;
+    }
+    dispatchAt(readyQueue, last);
+}
+
+/**
+ * HRRNP: preempt when a ready process's response ratio is strictly higher than the
+ * running one's (which also rises as its remaining time shrinks). Only once the
+ * running process has executed since its dispatch: the process switched out keeps
+ * gaining ratio while a context switch is paid, so they could trade the CPU forever
+ */
+void Scheduler::handleResponseRatioPreemption(std::stringstream& log) {
+    if (cpu.empty() || readyQueue.empty() || currentQuantumUsed == 0) return;
+    
+    advanceRatioHeap();
+    const Process& best = readyQueue[0];
+    if (!ratioAbove(best, cpu[0])) return;
+    
+    log << "Process " << cpu[0].id << " preempted by Process " << best.id << " (HRRNP). ";
+    if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, algorithm.c_str(), best.id, cpu[0].id)) {
+        addCandidate(*record, best);
+        addCandidate(*record, cpu[0]);
+    }
+    preemptCPU();
+}
+
+/**
+ * Pick the class to serve and dispatch from it using the class algorithm
+ * Strict: always the highest non-empty class
+ * TimeSlice: classes take turns of timeSlice ticks, skipping empty ones
+ */
+void Scheduler::scheduleMultilevel() {
+    if (!cpu.empty()) return;
+    
+    int cls = highestReadyClass();
+    if (cls == -1) return;
+    
+    if (interQueuePolicy == "TimeSlice") {
+        if (activeClass >= static_cast<int>(queueClasses.size()) ||
+            queueClasses[activeClass].readyQueue.empty()) {
+            activeClass = nextReadyClass(activeClass < static_cast<int>(queueClasses.size()) ? activeClass : -1);
+            classSliceUsed = 0;
+        }
+        cls = activeClass;
+    }
+    
+    dispatchFrom(queueClasses[cls].readyQueue, queueClasses[cls].algorithm);
+}
+
+/**
+ * Execute the current CPU process for one time unit
+ * Updates statistics and handles process completion
+ */
+void Scheduler::executeProcess() {
+    if (!cpu.empty()) {
+        if (dvfsEnabled) {
+            advanceWork(cpu[0], applyGovernor(0));
+            accountEnergy(0, true);
+        } else {
+            cpu[0].remainingTime--;
+        }
+        cpu[0].cpuTime++;
+        currentQuantumUsed++;
+        classSliceUsed++;
+        
+        // Check for completion
+        if (cpu[0].remainingTime <= 0) {
+            cpu[0].completionTime = currentTime + 1;
+            cpu[0].turnaroundTime = cpu[0].completionTime - cpu[0].arrivalTime;
+            // Ticks not spent executing; equals turnaround - burst unless DVFS changed the speed
+            cpu[0].waitingTime = cpu[0].turnaroundTime - cpu[0].cpuTime;
+            
+            if (burstPredictor != "None") observeBurst(cpu[0]);
+            releaseDependents(cpu[0]);
+            track(cpu[0], ProcessTable::FINISHED, -1, finishedProcesses.size());
+            finishedProcesses.push_back(cpu[0]);
+            cpu.clear();
+            currentQuantumUsed = 0;
+        }
+    }
+}
+
+/**
+ * Default operating points when none were configured
+ */
+void Scheduler::ensureFrequencyStates() {
+    if (frequencyStates.empty()) {
+        frequencyStates = {{800, 0.8}, {1600, 1.0}, {2400, 1.2}};
+    }
+    if (coreFreqLevel.size() != static_cast<size_t>(coreCount)) {
+        coreFreqLevel.assign(coreCount, static_cast<int>(frequencyStates.size()) - 1);
+        coreWasBusy.assign(coreCount, 0);
+    }
+}
+
+int Scheduler::referenceFrequency() const {
+    return referenceMHz > 0 ? referenceMHz : frequencyStates.back().mhz;
+}
+
+/**
+ * Governor decision for one core at the start of its tick
+ * ondemand: jump to the top state after a busy tick, step down one state after an idle one
+ */
+int Scheduler::applyGovernor(int core) {
+    ensureFrequencyStates();
+    int top = static_cast<int>(frequencyStates.size()) - 1;
+    int& level = coreFreqLevel[core];
+    
+    if (governor == "powersave") {
+        level = 0;
+    } else if (governor == "ondemand") {
+        level = coreWasBusy[core] ? top : std::max(0, level - 1);
+    } else {
+        level = top;
+    }
+    return frequencyStates[level].mhz;
+}
+
+/**
+ * Retire one tick of work at 'mhz'; remainingTime stays in reference-frequency ticks
+ */
+void Scheduler::advanceWork(Process& p, int mhz) {
+    long long ref = referenceFrequency();
+    if (p.remainingCycles < 0) {
+        p.remainingCycles = static_cast<long long>(p.remainingTime) * ref;
+    }
+    p.remainingCycles = std::max(0LL, p.remainingCycles - mhz);
+    p.remainingTime = (p.remainingCycles + ref - 1) / ref;
+}
+
+/**
+ * Static power is paid every tick; dynamic power only while the core executes
+ */
+void Scheduler::accountEnergy(int core, bool busy) {
+    ensureFrequencyStates();
+    const FrequencyState& fs = frequencyStates[coreFreqLevel[core]];
+    staticEnergy += staticPower;
+    if (busy) {
+        dynamicEnergy += capacitance * fs.voltage * fs.voltage * fs.mhz;
+        frequencyTicks += fs.mhz;
+        dvfsBusyTicks++;
+    }
+    coreWasBusy[core] = busy ? 1 : 0;
+}
+
+/**
+ * Update waiting times for all processes in ready queue
+ * Called once per tick for accurate statistics
+ */
+void Scheduler::updateWaitingTimes() {
+    waitClock++;
+    for (auto& p : readyQueue) {
+        p.waitingTime++;
+    }
+    for (auto& qc : queueClasses) {
+        for (auto& p : qc.readyQueue) {
+            p.waitingTime++;
+        }
+    }
+}
+
+namespace {
+
+// SplitMix64 finalizer of one (id, value) pair, for order-independent folds
+uint64_t mixPair(int64_t id, int64_t value) {
+    uint64_t z = static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(value);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+/**
+ * Apply aging mechanism to prevent starvation
+ * Increases priority (decreases value) for processes waiting too long
+ * The tick's boosts enter the state hash as one sum, so equivalent schedules
+ * hash alike whatever order their ready queues are kept in (sorted, heap, FIFO)
+ */
+void Scheduler::applyAging() {
+    if (!agingEnabled) return;
+    
+    uint64_t boosts = 0;
+    bool boosted = false;
+    auto age = [&](std::vector<Process>& queue) {
+        for (auto& p : queue) {
+            p.ageCounter++;
+            
+            // Apply priority boost at aging threshold
+            if (p.ageCounter >= agingThreshold) {
+                // Decrease priority value by agingBoostAmount (lower value = higher priority)
+                p.priority = std::max(0, p.priority - agingBoostAmount);
+                boosts += mixPair(p.id, p.priority);
+                boosted = true;
+                if (p.basePriority != -1) {
+                    p.basePriority = std::max(0, p.basePriority - agingBoostAmount);
+                }
+                p.ageCounter = 0;  // Reset counter after boost
+            }
+        }
+    };
+    
+    age(readyQueue);
+    for (auto& qc : queueClasses) {
+        age(qc.readyQueue);
+    }
+    if (boosted) {
+        hashEvent(static_cast<int64_t>(boosts));
+        if (priorityExpr.uses(PriorityExpr::PRIORITY)) exprHeapSize = 0;  // Cached scores read priority
+    }
+}
+
+/**
+ * Apply the preemption rule of 'algo' to the running process against 'queue'
+ */
+void Scheduler::handlePreemption(std::stringstream& log, std::vector<Process>& queue,
+                                 const std::string& algo, SimTime quantum) {
+    // Round Robin: Check quantum expiration
+    if (algo == "RR" && !cpu.empty() && cpu[0].remainingTime > 0) {
+        if (currentQuantumUsed >= quantum) {
+            log << "Process " << cpu[0].id << " quantum expired. ";
+            if (DecisionRecord* record = beginDecision(DecisionRecord::QUANTUM_EXPIRED, algo.c_str(), -1,
+                                                       cpu[0].id)) {
+                addCandidate(*record, cpu[0]);
+            }
+            preemptCPU();
+        }
+    }
+    
+    // SRTF: Check for shorter process
+    if (algo == "SRTF" && shouldPreemptSRTF(queue)) {
+        const Process& shortestInQueue = queue[shortestRemainingIndex(queue)];
+        log << "Process " << cpu[0].id << " preempted by Process " 
+            << shortestInQueue.id << " (SRTF). ";
+        if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, algo.c_str(), shortestInQueue.id,
+                                                   cpu[0].id)) {
+            addCandidate(*record, shortestInQueue);
+            addCandidate(*record, cpu[0]);
+        }
+        preemptCPU();
+    }
+    
+    // HRRNP: Check for a higher response ratio (see handleResponseRatioPreemption)
+    if (algo == "HRRNP" && !cpu.empty() && !queue.empty() && currentQuantumUsed > 0) {
+        const Process& highestInQueue = queue[highestRatioIndex(queue)];
+        if (ratioAbove(highestInQueue, cpu[0])) {
+            log << "Process " << cpu[0].id << " preempted by Process " << highestInQueue.id << " (HRRNP). ";
+            if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, algo.c_str(), highestInQueue.id,
+                                                       cpu[0].id)) {
+                addCandidate(*record, highestInQueue);
+                addCandidate(*record, cpu[0]);
+            }
+            preemptCPU();
+        }
+    }
+    
+    // Priority (Preemptive): Check for higher priority process
+    if (algo == "Priority" && shouldPreemptPriority(queue)) {
+        const Process& highestInQueue = queue[highestPriorityIndex(queue)];
+        log << "Process " << cpu[0].id << " preempted by Process " 
+            << highestInQueue.id << " (Priority " << highestInQueue.priority 
+            << " < " << cpu[0].priority << "). ";
+        if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, algo.c_str(), highestInQueue.id,
+                                                   cpu[0].id)) {
+            addCandidate(*record, highestInQueue);
+            addCandidate(*record, cpu[0]);
+        }
+        preemptCPU();
+    }
+}
+
+/**
+ * Ask the plug-in whether the running process should give up the CPU
+ */
+void Scheduler::handlePolicyPreemption(std::stringstream& log) {
+    if (cpu.empty() || readyQueue.empty() || !policyWants(SCHED_POLICY_HOOK_PREEMPT)) return;
+    if (!policy->table.should_preempt(policy->table.state, &stagePolicyView())) return;
+    
+    log << "Process " << cpu[0].id << " preempted (" << policyRule << "). ";
+    if (DecisionRecord* record = beginDecision(DecisionRecord::PREEMPT, policyRule.c_str(), -1, cpu[0].id)) {
+        addCandidate(*record, cpu[0]);
+        addCandidates(*record, readyQueue);
+    }
+    preemptCPU();
+}
+
+namespace {
+
+void stagePolicyProcess(const Process& p, sched_policy_process& out) {
+    out.id = p.id;
+    out.priority = p.priority;
+    out.arrival = p.arrivalTime;
+    out.burst = p.burstTime;
+    out.remaining = p.remainingTime;
+    out.waiting = p.waitingTime;
+    out.start = p.startTime;
+}
+
+}
+
+bool Scheduler::policyWants(uint32_t hook) const {
+    return policy && algorithm == "Plugin" && policy->wants(hook);
+}
+
+/**
+ * Copy the ready queue and CPU into the plug-in view
+ * Only called for hooks the policy declared, so other policies pay nothing
+ */
+const sched_policy_view& Scheduler::stagePolicyView() {
+    policyReady.resize(readyQueue.size());
+    for (size_t i = 0; i < readyQueue.size(); ++i) {
+        stagePolicyProcess(readyQueue[i], policyReady[i]);
+    }
+    if (!cpu.empty()) stagePolicyProcess(cpu[0], policyRunning);
+    
+    policyView.now = currentTime;
+    policyView.time_resolution = timeResolution;
+    policyView.quantum = timeQuantum;
+    policyView.quantum_used = currentQuantumUsed;
+    policyView.running = cpu.empty() ? nullptr : &policyRunning;
+    policyView.ready = policyReady.data();
+    policyView.ready_count = policyReady.size();
+    return policyView;
+}
+
+/**
+ * Find a live process by id wherever it currently resides
+ * Through the lookup index, which is kept current as processes move
+ */
+Process* Scheduler::findActive(int id) {
+    auto it = slotOfId.find(id);
+    if (it == slotOfId.end()) return nullptr;
+    
+    uint8_t where = slotWhere[it->second];
+    bool live = where == ProcessTable::READY || where == ProcessTable::RUNNING ||
+                where == ProcessTable::BLOCKED;
+    return live ? const_cast<Process*>(locate(it->second)) : nullptr;
+}
+
+void Scheduler::boostPriority(Process& p, int priority) {
+    if (priority >= p.priority) return;
+    if (p.basePriority == -1) p.basePriority = p.priority;
+    p.priority = priority;
+    hashEvent(p.id);
+    hashEvent(priority);
+    if (priorityExpr.uses(PriorityExpr::PRIORITY)) exprHeapSize = 0;  // Cached scores read priority
+}
+
+/**
+ * Drop any inherited/ceiling boost, then re-apply boosts still owed by held locks
+ */
+void Scheduler::restorePriority(Process& p) {
+    if (p.basePriority != -1) {
+        p.priority = p.basePriority;
+        p.basePriority = -1;
+        hashEvent(p.id);
+        hashEvent(p.priority);
+        if (priorityExpr.uses(PriorityExpr::PRIORITY)) exprHeapSize = 0;
+    }
+    
+    for (int request : p.heldRequests) {
+        const SimLock& lock = locks[p.lockRequests[request].lockId];
+        if (lockProtocol == "Ceiling") {
+            boostPriority(p, lock.ceiling);
+        } else if (lockProtocol == "Inheritance") {
+            for (const auto& w : lock.waiters) {
+                boostPriority(p, w.priority);
+            }
+        }
+    }
+}
+
+/**
+ * Priority inheritance: raise the holder chain to the blocked waiter's priority
+ */
+void Scheduler::propagateInheritance(int holderId, int priority) {
+    // Bounded by the number of locks to stay safe on circular waits
+    for (size_t hops = 0; hops <= locks.size() && holderId != -1; ++hops) {
+        Process* holder = findActive(holderId);
+        if (!holder || holder->priority <= priority) return;
+        
+        boostPriority(*holder, priority);
+        if (holder->blockedOn == -1) return;
+        holderId = locks[holder->blockedOn].owner;
+    }
+}
+
+/**
+ * First request whose interval covers the executed time and that is not held yet
+ * A blocked process keeps the same due request until ownership is handed to it
+ */
+int Scheduler::dueLockRequest(const Process& p) const {
+    SimTime executed = p.burstTime - p.remainingTime;
+    for (size_t i = 0; i < p.lockRequests.size(); ++i) {
+        const LockRequest& req = p.lockRequests[i];
+        if (req.acquireAt <= executed && executed < req.releaseAt &&
+            std::find(p.heldRequests.begin(), p.heldRequests.end(), static_cast<int>(i)) == p.heldRequests.end()) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Scheduler::grantLock(Process& p, int request) {
+    SimLock& lock = locks[p.lockRequests[request].lockId];
+    lock.owner = p.id;
+    p.heldRequests.push_back(request);
+    
+    if (lockProtocol == "Ceiling") {
+        boostPriority(p, lock.ceiling);
+    } else if (lockProtocol == "Inheritance") {
+        for (const auto& w : lock.waiters) {
+            boostPriority(p, w.priority);
+        }
+    }
+}
+
+/**
+ * Handle lock acquisition for the dispatched process
+ * A process that finds its lock taken is parked on the lock and the CPU is refilled
+ */
+void Scheduler::acquireLocks(std::stringstream& log) {
+    while (!cpu.empty()) {
+        Process& p = cpu[0];
+        int request = dueLockRequest(p);
+        if (request == -1) return;
+        
+        int lockId = p.lockRequests[request].lockId;
+        SimLock& lock = locks[lockId];
+        if (lock.owner == -1) {
+            grantLock(p, request);
+            log << "Process " << p.id << " acquired L" << lockId << ". ";
+            continue;
+        }
+        
+        log << "Process " << p.id << " blocked on L" << lockId 
+            << " (held by Process " << lock.owner << "). ";
+        p.blockedOn = lockId;
+        int waiterPriority = p.priority;
+        track(p, ProcessTable::BLOCKED, lockId, lock.waiters.size());
+        lock.waiters.push_back(p);
+        contendedLocks.insert(lockId);
+        blockedCount++;
+        cpu.clear();
+        currentQuantumUsed = 0;
+        
+        if (lockProtocol == "Inheritance") {
+            propagateInheritance(lock.owner, waiterPriority);
+        }
+        scheduleNextProcess();
+    }
+}
+
+/**
+ * Release locks whose release offset was reached (or every held lock when 'all')
+ * Ownership passes directly to the highest-priority waiter, which becomes ready
+ */
+void Scheduler::releaseLocks(Process& p, bool all, std::stringstream& log) {
+    if (p.heldRequests.empty()) return;
+    
+    // Held requests are checked by index, so an earlier request for the same lock
+    // that is already past its release offset can't drop a later acquisition
+    SimTime executed = p.burstTime - p.remainingTime;
+    std::vector<int> released;
+    for (size_t i = 0; i < p.lockRequests.size(); ++i) {
+        auto held = std::find(p.heldRequests.begin(), p.heldRequests.end(), static_cast<int>(i));
+        if (held != p.heldRequests.end() && (all || p.lockRequests[i].releaseAt <= executed)) {
+            released.push_back(p.lockRequests[i].lockId);
+            p.heldRequests.erase(held);
+        }
+    }
+    if (released.empty()) return;
+    
+    for (int lockId : released) {
+        SimLock& lock = locks[lockId];
+        lock.owner = -1;
+        log << "Process " << p.id << " released L" << lockId << ". ";
+        
+        if (lock.waiters.empty()) continue;
+        
+        auto next = std::min_element(lock.waiters.begin(), lock.waiters.end(),
+            [](const Process& a, const Process& b){
+                if (a.priority != b.priority) return a.priority < b.priority;
+                if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+                return a.id < b.id;
+            });
+        Process woken = *next;
+        size_t index = next - lock.waiters.begin();
+        lock.waiters.erase(next);
+        renumber(lock.waiters, index);
+        if (lock.waiters.empty()) contendedLocks.erase(lockId);
+        blockedCount--;
+        
+        woken.blockedOn = -1;
+        grantLock(woken, dueLockRequest(woken));
+        log << "Process " << woken.id << " acquired L" << lockId << ". ";
+        pushReady(std::move(woken));
+    }
+    
+    restorePriority(p);
+}
+
+/**
+ * Accumulate blocked and priority-inversion time for parked processes
+ * Inversion: the running process has a worse base priority than a blocked waiter
+ */
+void Scheduler::accountBlocked() {
+    if (blockedCount == 0) return;
+    
+    for (int lockId : contendedLocks) {
+        SimLock& lock = locks[lockId];
+        for (auto& w : lock.waiters) {
+            w.blockedTime++;
+            if (cpu.empty()) continue;
+            
+            int runnerBase = cpu[0].basePriority != -1 ? cpu[0].basePriority : cpu[0].priority;
+            if (runnerBase > w.priority) {
+                w.inversionTime++;
+                inversionTicks++;
+                if (cpu[0].id != lock.owner) unboundedInversionTicks++;
+            }
+        }
+    }
+}
+
+/**
+ * MLQ preemption: inter-queue policy first, then the running class's own rule
+ */
+void Scheduler::handleMultilevelPreemption(std::stringstream& log) {
+    if (cpu.empty()) return;
+    
+    int cls = std::min(std::max(0, cpu[0].queueClass), static_cast<int>(queueClasses.size()) - 1);
+    
+    if (interQueuePolicy == "TimeSlice") {
+        if (classSliceUsed >= queueClasses[cls].timeSlice) {
+            int next = nextReadyClass(cls);
+            classSliceUsed = 0;
+            if (next != -1 && next != cls) {
+                log << "Class " << cls << " slice expired, switching to class " << next << ". ";
+                if (DecisionRecord* record = beginDecision(DecisionRecord::CLASS_PREEMPT, "MLQ", -1,
+                                                           cpu[0].id)) {
+                    addCandidate(*record, cpu[0]);
+                    addCandidates(*record, queueClasses[next].readyQueue);
+                }
+                preemptCPU();
+                activeClass = next;
+                return;
+            }
+        }
+    } else {
+        int top = highestReadyClass();
+        if (top != -1 && top < cls) {
+            log << "Process " << cpu[0].id << " preempted by class " << top << " queue. ";
+            if (DecisionRecord* record = beginDecision(DecisionRecord::CLASS_PREEMPT, "MLQ", -1,
+                                                       cpu[0].id)) {
+                addCandidate(*record, cpu[0]);
+                addCandidates(*record, queueClasses[top].readyQueue);
+            }
+            preemptCPU();
+            return;
+        }
+    }
+    
+    QueueClass& qc = queueClasses[cls];
+    handlePreemption(log, qc.readyQueue, qc.algorithm, qc.timeQuantum);
+}
+
+/**
+ * Main simulation tick - executes one time unit
+ * Order of operations is critical for correct algorithm behavior
+ */
+std::string Scheduler::tick() {
+    if (algorithm == "Gang") return tickGang();
+    
+    std::stringstream log;
+    log << "Time " << formatTime(currentTime) << ": ";
+
+    // === PHASE 1: Check for new arrivals (BEFORE preemption checks) ===
+    // New arrivals join the ready queue
+    checkArrivals();
+
+    // === PHASE 2: Handle preemption based on algorithm ===
+    if (algorithm == "MLQ") {
+        handleMultilevelPreemption(log);
+    } else if (algorithm == "ExprP") {
+        handleExpressionPreemption(log);
+    } else if (algorithm == "HRRNP") {
+        handleResponseRatioPreemption(log);
+    } else if (algorithm == "Plugin") {
+        handlePolicyPreemption(log);
+    } else {
+        handlePreemption(log, readyQueue, algorithm, timeQuantum);
+    }
+    
+    // === PHASE 3: Schedule next process if CPU is idle ===
+    scheduleNextProcess();
+    acquireLocks(log);
+    accountBlocked();
+    
+    // Idle core still draws static power under DVFS
+    if (dvfsEnabled && cpu.empty()) {
+        applyGovernor(0);
+        accountEnergy(0, false);
+    }
+    
+    // === PHASE 4: Execute current process ===
+    if (!cpu.empty() && switchRemaining > 0) {
+        // Context switch overhead: CPU is occupied but the process makes no progress
+        lastExecutedName = "";
+        lastExecutedId = -1;
+        switchRemaining--;
+        log << "Context switch to Process " << cpu[0].id << ".";
+        updateWaitingTimes();
+    } else if (!cpu.empty()) {
+        // Track what's running BEFORE execution (for accurate Gantt display)
+        lastExecutedName = cpu[0].name;
+        lastExecutedId = cpu[0].id;
+        
+        SimTime remainingBefore = cpu[0].remainingTime;
+        log << "Running Process " << cpu[0].id << " (" << formatTime(remainingBefore) << " remaining). ";
+        
+        executeProcess();
+        updateWaitingTimes(); // Update stats for waiting processes
+        
+        // Check if process just finished
+        if (cpu.empty()) {
+            releaseLocks(finishedProcesses.back(), true, log);
+            log << "Process " << finishedProcesses.back().id << " finished.";
+            if (policyWants(SCHED_POLICY_HOOK_COMPLETE)) {
+                sched_policy_process done;
+                stagePolicyProcess(finishedProcesses.back(), done);
+                policy->table.on_complete(policy->table.state, &done, currentTime + 1);
+            }
+        } else {
+            releaseLocks(cpu[0], false, log);
+        }
+    } else if (blockedCount > 0 && jobPool.empty() && 
+               readyQueue.empty() && highestReadyClass() == -1) {
+        lastExecutedName = "";
+        lastExecutedId = -1;
+        deadlocked = true;
+        log << "Deadlock: " << blockedCount << " process(es) blocked on locks.";
+    } else {
+        lastExecutedName = "";
+        lastExecutedId = -1;
+        log << "CPU Idle.";
+    }
+    
+    // === PHASE 5: Apply aging (end of tick) ===
+    applyAging();
+    if (agingEnabled) {
+        auto logAged = [&log](const std::vector<Process>& queue) {
+            for (const auto &p : queue) {
+                if (p.ageCounter == 0 && p.priority < p.originalPriority) {
+                    log << " [Aged: P" << p.id << " priority=" << p.priority << "]";
+                }
+            }
+        };
+        logAged(readyQueue);
+        for (const auto& qc : queueClasses) {
+            logAged(qc.readyQueue);
+        }
+    }
+    if (policyWants(SCHED_POLICY_HOOK_TICK)) {
+        policy->table.on_tick(policy->table.state, &stagePolicyView());
+    }
+    
+    return endTick(log.str());
+}
+
+/**
+ * Run ticks until 'budgetMs' of wall-clock time is spent, 'maxTicks' ticks have run
+ * (0 = no cap) or the simulation finishes. At least one tick runs if any work is
+ * left, so a tiny budget still makes progress
+ */
+RunSummary Scheduler::runFor(double budgetMs, int maxTicks) {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    const Clock::duration budget = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(budgetMs));
+    
+    RunSummary summary;
+    Clock::duration elapsed(0);
+    while (!isFinished() && (maxTicks <= 0 || summary.ticks < maxTicks)) {
+        if (summary.ticks > 0) summary.log += '\n';
+        summary.log += tick();
+        summary.ticks++;
+        
+        elapsed = Clock::now() - start;
+        if (elapsed >= budget) break;
+    }
+    
+    summary.time = currentTime / static_cast<double>(timeResolution);
+    summary.finished = isFinished();
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(elapsed).count();
+    return summary;
+}
+
+/**
+ * Retain the tick's log, advance the clock and make the tick visible to
+ * zero-copy readers. Returns 'log' for tick() to hand back
+ */
+std::string Scheduler::endTick(std::string log) {
+    if (logCapacity > 0) retainLog(log);
+    
+    hashEvent(currentTime);
+    hashEvent(lastExecutedId);
+    for (; hashedFinished < finishedProcesses.size(); ++hashedFinished) {
+        const Process& p = finishedProcesses[hashedFinished];
+        hashEvent(p.id);
+        hashEvent(p.completionTime);
+        hashEvent(p.waitingTime);
+        hashEvent(p.responseTime);
+    }
+    
+    currentTime++;
+    stateVersion++;
+    if (recordTimeline) {
+        if (timeline.size() >= timelineCapacity) trimTimeline(timelineCapacity / 2);
+        timeline.push_back(lastExecutedId);
+    }
+    return log;
+}
+
+/**
+ * Mark every core free
+ */
+void Scheduler::resetCores() {
+    coreFreqLevel.clear();
+    coreWasBusy.clear();
+    freeCoreMask.assign((coreCount + 63) / 64, 0);
+    for (int core = 0; core < coreCount; ++core) {
+        freeCoreMask[core / 64] |= uint64_t(1) << (core % 64);
+    }
+    freeCoreCount = coreCount;
+    coreOwner.assign(coreCount, -1);
+}
+
+/**
+ * Claim 'count' free cores, scanning the packed mask a word at a time
+ * All-or-nothing: fails without side effects if too few cores are free
+ */
+bool Scheduler::allocateCores(int count, std::vector<int>& cores) {
+    if (count > freeCoreCount) return false;
+    
+    cores.clear();
+    for (size_t w = 0; w < freeCoreMask.size() && static_cast<int>(cores.size()) < count; ++w) {
+        uint64_t bits = freeCoreMask[w];
+        while (bits && static_cast<int>(cores.size()) < count) {
+            int bit = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            cores.push_back(static_cast<int>(w * 64 + bit));
+        }
+    }
+    for (int core : cores) {
+        freeCoreMask[core / 64] &= ~(uint64_t(1) << (core % 64));
+    }
+    freeCoreCount -= count;
+    return true;
+}
+
+void Scheduler::releaseCores(Process& p) {
+    for (int core : p.assignedCores) {
+        freeCoreMask[core / 64] |= uint64_t(1) << (core % 64);
+        coreOwner[core] = -1;
+    }
+    freeCoreCount += static_cast<int>(p.assignedCores.size());
+    p.assignedCores.clear();
+}
+
+/**
+ * First-fit gang dispatch in ready-queue order
+ * A gang runs only when all of its threads get a core in the same slot
+ */
+void Scheduler::dispatchGangs(std::stringstream& log) {
+    size_t firstTaken = readyQueue.size();
+    auto it = readyQueue.begin();
+    while (it != readyQueue.end() && freeCoreCount > 0) {
+        int needed = std::min(it->threadCount, coreCount);
+        std::vector<int> cores;
+        if (!allocateCores(needed, cores)) {
+            ++it;
+            continue;
+        }
+        
+        if (DecisionRecord* record = beginDecision(DecisionRecord::DISPATCH, "Gang", it->id, -1)) {
+            addCandidates(*record, readyQueue);
+        }
+        
+        Process p = *it;
+        firstTaken = std::min(firstTaken, static_cast<size_t>(it - readyQueue.begin()));
+        it = readyQueue.erase(it);
+        p.assignedCores = cores;
+        for (int core : cores) {
+            coreOwner[core] = p.id;
+        }
+        if (p.startTime == -1) {
+            p.startTime = currentTime;
+            p.responseTime = currentTime - p.arrivalTime;
+        }
+        log << "Gang " << p.id << " -> " << needed << " core(s). ";
+        track(p, ProcessTable::RUNNING, -2, gangRunning.size());
+        gangRunning.push_back(p);
+    }
+    renumber(readyQueue, firstTaken);
+}
+
+/**
+ * Gang scheduling tick
+ * Slots last timeQuantum ticks; at a slot boundary every gang is preempted and
+ * cores are refilled first-fit, so gangs rotate like Round Robin
+ */
+std::string Scheduler::tickGang() {
+    std::stringstream log;
+    log << "Time " << formatTime(currentTime) << ": ";
+    
+    checkArrivals();
+    
+    // Slot boundary: all gangs leave their cores together. The slot also ends when
+    // its gangs finished on its last tick, so the next dispatch gets a full slot
+    if (gangSlotUsed >= timeQuantum) {
+        if (!gangRunning.empty()) log << "Slot ended. ";
+        for (auto& g : gangRunning) {
+            releaseCores(g);
+            track(g, ProcessTable::READY, -1, readyQueue.size());
+            readyQueue.push_back(g);
+        }
+        gangRunning.clear();
+        gangSlotUsed = 0;
+    }
+    
+    dispatchGangs(log);
+    
+    // Core accounting for this slot tick
+    int idle = freeCoreCount;
+    busyCoreTicks += coreCount - idle;
+    idleCoreTicks += idle;
+    if (idle > 0 && !readyQueue.empty()) {
+        fragmentedCoreTicks += idle;
+    }
+    
+    // Per-core operating points; a gang advances at its slowest core's speed
+    std::vector<int> coreMHz;
+    if (dvfsEnabled) {
+        coreMHz.resize(coreCount);
+        for (int core = 0; core < coreCount; ++core) {
+            coreMHz[core] = applyGovernor(core);
+            accountEnergy(core, coreOwner[core] != -1);
+        }
+    }
+    
+    if (gangRunning.empty()) {
+        lastExecutedName = "";
+        lastExecutedId = -1;
+        gangSlotUsed = 0;
+        log << "CPU Idle.";
+    } else {
+        lastExecutedName = gangRunning.front().name;
+        lastExecutedId = gangRunning.front().id;
+        
+        size_t firstFinished = gangRunning.size();
+        auto it = gangRunning.begin();
+        while (it != gangRunning.end()) {
+            log << "Running Gang " << it->id << " (" << formatTime(it->remainingTime) << " remaining). ";
+            if (dvfsEnabled) {
+                int mhz = coreMHz[it->assignedCores.front()];
+                for (int core : it->assignedCores) {
+                    mhz = std::min(mhz, coreMHz[core]);
+                }
+                advanceWork(*it, mhz);
+            } else {
+                it->remainingTime--;
+            }
+            it->cpuTime++;
+            if (it->remainingTime <= 0) {
+                it->completionTime = currentTime + 1;
+                it->turnaroundTime = it->completionTime - it->arrivalTime;
+                it->waitingTime = it->turnaroundTime - it->cpuTime;
+                releaseCores(*it);
+                log << "Gang " << it->id << " finished. ";
+                releaseDependents(*it);
+                track(*it, ProcessTable::FINISHED, -1, finishedProcesses.size());
+                finishedProcesses.push_back(*it);
+                firstFinished = std::min(firstFinished, static_cast<size_t>(it - gangRunning.begin()));
+                it = gangRunning.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        renumber(gangRunning, firstFinished);
+        gangSlotUsed++;
+        updateWaitingTimes();
+    }
+    
+    return endTick(log.str());
+}
+
+/**
+ * Convert a user-facing time to base units (exact for integers at resolution 1)
+ */
+SimTime Scheduler::toBase(double t) const {
+    return static_cast<SimTime>(std::llround(t * static_cast<double>(timeResolution)));
+}
+
+#ifndef SCHEDULER_NO_JSON
+/**
+ * Report a base-unit time in user units
+ * Stays an integer at resolution 1 so existing consumers see unchanged JSON
+ */
+nlohmann::json Scheduler::toUnits(SimTime t) const {
+    if (timeResolution == 1) return t;
+    return static_cast<double>(t) / static_cast<double>(timeResolution);
+}
+#endif
+
+/**
+ * Text form of a time in user units, as getStateJSON() prints it
+ * Builds without nlohmann::json print the shortest round-trip %g form instead
+ */
+std::string Scheduler::formatTime(SimTime t) const {
+    if (timeResolution == 1) return std::to_string(t);
+#ifndef SCHEDULER_NO_JSON
+    return toUnits(t).dump();
+#else
+    double v = static_cast<double>(t) / static_cast<double>(timeResolution);
+    char buf[32];
+    for (int precision = 1; precision <= 17; ++precision) {
+        std::snprintf(buf, sizeof(buf), "%.*g", precision, v);
+        if (std::strtod(buf, nullptr) == v) break;
+    }
+    return buf;
+#endif
 }
 
-void Scheduler::setAlgorithm(std::string algo) {
-    algorithm = algo;
+const std::vector<Process>& Scheduler::getFinishedProcesses() const {
+    return finishedProcesses;
 }
 
-void Scheduler::setTimeQuantum(int q) {
-    timeQuantum = q;
+namespace {
+
+/**
+ * First logical index of a time-ordered ring whose entry is at or after 'from'
+ */
+template <typename At>
+size_t firstAtOrAfter(size_t size, At at, SimTime from) {
+    size_t lo = 0, hi = size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (at(mid).time < from) lo = mid + 1; else hi = mid;
+    }
+    return lo;
 }
 
-void Scheduler::setAging(bool enabled) {
-    agingEnabled = enabled;
 }
 
-void Scheduler::setAgingThreshold(int threshold) {
-    agingThreshold = threshold;
+/**
+ * Record that 'p' is about to be appended at 'pos' of the container (where, container)
+ * Called at every site that moves a process between containers, so the index
+ * never needs a walk over the queues
+ */
+void Scheduler::track(const Process& p, uint8_t where, int32_t container, size_t pos) {
+    slotWhere[p.slot] = where;
+    slotContainer[p.slot] = container;
+    slotPos[p.slot] = static_cast<uint32_t>(pos);
 }
 
-void Scheduler::setAgingBoostAmount(int amount) {
-    agingBoostAmount = amount;
+/**
+ * Record the positions of queue[from, end) after a sort or erase shifted them
+ */
+void Scheduler::renumber(const std::vector<Process>& queue, size_t from) {
+    for (size_t i = from; i < queue.size(); ++i) {
+        slotPos[queue[i].slot] = static_cast<uint32_t>(i);
+    }
 }
 
-bool Scheduler::isFinished() const {
-    return jobPool.empty() && readyQueue.empty() && cpu.empty();
+void Scheduler::swapReady(size_t a, size_t b) {
+    std::swap(readyQueue[a], readyQueue[b]);
+    slotPos[readyQueue[a].slot] = static_cast<uint32_t>(a);
+    slotPos[readyQueue[b].slot] = static_cast<uint32_t>(b);
 }
 
 /**
- * Check for process arrivals and move them to ready queue
- * Processes are added in arrival order (FIFO within same arrival time)
+ * The current record of the process in 'slot', straight from its container and position
  */
-void Scheduler::checkArrivals() {
-    auto it = jobPool.begin();
-    while (it != jobPool.end()) {
-        if (it->arrivalTime <= currentTime) {
-            readyQueue.push_back(*it);
-            it = jobPool.erase(it);
-        } else {
-            ++it;
+const Process* Scheduler::locate(int slot) const {
+    const std::vector<Process>* queue = nullptr;
+    int32_t container = slotContainer[slot];
+    switch (slotWhere[slot]) {
+        case ProcessTable::NOT_ARRIVED:
+            queue = container == -3 ? &heldProcesses : &jobPool;
+            break;
+        case ProcessTable::READY:
+            if (container < 0) queue = &readyQueue;
+            else if (container < static_cast<int32_t>(queueClasses.size())) queue = &queueClasses[container].readyQueue;
+            break;
+        case ProcessTable::RUNNING:
+            queue = container == -2 ? &gangRunning : &cpu;
+            break;
+        case ProcessTable::BLOCKED: {
+            auto it = locks.find(container);
+            if (it != locks.end()) queue = &it->second.waiters;
+            break;
         }
+        case ProcessTable::FINISHED:
+            queue = &finishedProcesses;
+            break;
     }
+    
+    if (!queue) return nullptr;
+    uint32_t pos = slotPos[slot];
+    if (pos < queue->size() && (*queue)[pos].slot == slot) return &(*queue)[pos];
+    return nullptr;  // Between containers mid-tick
+}
+
+Process* Scheduler::findProcess(int id) {
+    return const_cast<Process*>(getProcess(id));
 }
 
 /**
- * Preempt the currently running process
- * Moves CPU process back to ready queue
+ * Current record of process 'id'
+ * Exact between ticks; the pointer is valid until the next tick()/addProcess()
  */
-void Scheduler::preemptCPU() {
-    if (!cpu.empty()) {
-        Process p = cpu.front();
-        cpu.clear();
-        readyQueue.push_back(p);
-        currentQuantumUsed = 0;
-    }
+const Process* Scheduler::getProcess(int id) const {
+    auto it = slotOfId.find(id);
+    return it == slotOfId.end() ? nullptr : locate(it->second);
 }
 
-// Sorting helpers
-void Scheduler::sortBySJF() {
-    std::sort(readyQueue.begin(), readyQueue.end(), [](const Process& a, const Process& b){
-        if (a.burstTime != b.burstTime) return a.burstTime < b.burstTime;
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+std::vector<int> Scheduler::getProcessIdsByName(const std::string& name) const {
+    auto it = nameIds.find(name);
+    return it == nameIds.end() ? std::vector<int>() : idsByName[it->second];
 }
 
-void Scheduler::sortBySRTF() {
-    std::sort(readyQueue.begin(), readyQueue.end(), [](const Process& a, const Process& b){
-        if (a.remainingTime != b.remainingTime) return a.remainingTime < b.remainingTime;
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+/**
+ * Keep the most recent 'entries' tick logs; shrinking drops the oldest
+ */
+void Scheduler::setLogCapacity(size_t entries) {
+    std::vector<LogRecord> kept;
+    std::string text;
+    size_t keep = std::min(entries, logRing.size());
+    for (size_t i = logRing.size() - keep; i < logRing.size(); ++i) {
+        LogRecord record = logRing[(logStart + i) % logRing.size()];
+        size_t offset = text.size();
+        text.append(logText, record.offset - logTextBase, record.length);
+        record.offset = offset;
+        kept.push_back(record);
+    }
+    logRing = std::move(kept);
+    logText = std::move(text);
+    logTextBase = 0;
+    logStart = 0;
+    logCapacity = entries;
 }
 
-void Scheduler::sortByPriority() {
-    std::sort(readyQueue.begin(), readyQueue.end(), [](const Process& a, const Process& b){
-        if (a.priority != b.priority) return a.priority < b.priority;
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+/**
+ * Record one tick log; once the ring is full the oldest record is overwritten
+ * and its text compacted away when the dropped prefix outgrows the kept text
+ */
+void Scheduler::retainLog(const std::string& log) {
+    LogRecord record = {currentTime, logTextBase + logText.size(), static_cast<uint32_t>(log.size())};
+    logText += log;
+    if (logRing.size() < logCapacity) {
+        logRing.push_back(record);
+        return;
+    }
+    logRing[logStart] = record;
+    logStart = (logStart + 1) % logCapacity;
+    
+    size_t dropped = logRing[logStart].offset - logTextBase;
+    if (dropped > logText.size() / 2) {
+        logText.erase(0, dropped);
+        logTextBase += dropped;
+    }
 }
 
 /**
- * Check if SRTF preemption should occur
- * Returns true if a ready process has shorter remaining time than current CPU process
+ * Up to 'count' retained log lines from the first tick at or after 'fromTime'
  */
-bool Scheduler::shouldPreemptSRTF() {
-    if (cpu.empty() || readyQueue.empty()) return false;
+std::vector<LogEntry> Scheduler::getLog(double fromTime, size_t count) const {
+    SimTime from = toBase(fromTime);
+    size_t size = logRing.size();
+    auto at = [&](size_t i) -> const LogRecord& {
+        return logRing[(logStart + i) % size];
+    };
     
-    auto shortestInQueue = std::min_element(readyQueue.begin(), readyQueue.end(), 
-        [](const Process& a, const Process& b){
-            if (a.remainingTime != b.remainingTime) return a.remainingTime < b.remainingTime;
-            return a.id < b.id;
-        });
-        
-    return shortestInQueue->remainingTime < cpu[0].remainingTime;
+    std::vector<LogEntry> page;
+    for (size_t i = firstAtOrAfter(size, at, from); i < size && page.size() < count; ++i) {
+        const LogRecord& record = at(i);
+        page.push_back({record.time, logText.substr(record.offset - logTextBase, record.length)});
+    }
+    return page;
+}
+
+size_t Scheduler::getFinishedCount() const {
+    return finishedProcesses.size();
 }
 
 /**
- * Check if Priority preemption should occur
- * Returns true if a ready process has higher priority (lower value) than current CPU process
+ * Finished indices ordered by 'sortBy', ties in finish order
+ * Finished records are append-only, so each call only sorts the new tail and
+ * merges it into the cached order
  */
-bool Scheduler::shouldPreemptPriority() {
-    if (cpu.empty() || readyQueue.empty()) return false;
+const std::vector<uint32_t>& Scheduler::finishedOrderFor(const std::string& sortBy) {
+    bool descending = !sortBy.empty() && sortBy[0] == '-';
+    std::string key = descending ? sortBy.substr(1) : sortBy;
     
-    auto highestPriorityInQueue = std::min_element(readyQueue.begin(), readyQueue.end(), 
-        [](const Process& a, const Process& b){
-            if (a.priority != b.priority) return a.priority < b.priority;
-            return a.id < b.id;
-        });
-        
-    return highestPriorityInQueue->priority < cpu[0].priority;
+    SimTime Process::*field = nullptr;
+    int Process::*intField = nullptr;
+    if (key == "id") intField = &Process::id;
+    else if (key == "priority") intField = &Process::originalPriority;
+    else if (key == "arrival") field = &Process::arrivalTime;
+    else if (key == "burst") field = &Process::burstTime;
+    else if (key == "completion") field = &Process::completionTime;
+    else if (key == "waiting") field = &Process::waitingTime;
+    else if (key == "turnaround") field = &Process::turnaroundTime;
+    else if (key == "response") field = &Process::responseTime;
+    else {
+        // Unknown keys fall back to finish order and share its cache entry
+        descending = false;
+        key.clear();
+    }
+    
+    std::vector<uint32_t>& order = finishedOrder[descending ? "-" + key : key];
+    size_t sorted = order.size();
+    if (sorted == finishedProcesses.size()) return order;
+    
+    for (size_t i = sorted; i < finishedProcesses.size(); ++i) {
+        order.push_back(static_cast<uint32_t>(i));
+    }
+    if (!field && !intField) return order;
+    
+    auto value = [&](uint32_t i) -> SimTime {
+        const Process& p = finishedProcesses[i];
+        return field ? p.*field : p.*intField;
+    };
+    auto before = [&](uint32_t a, uint32_t b) {
+        return descending ? value(a) > value(b) : value(a) < value(b);
+    };
+    std::stable_sort(order.begin() + sorted, order.end(), before);
+    std::inplace_merge(order.begin(), order.begin() + sorted, order.end(), before);
+    return order;
 }
 
 /**
- * Select and dispatch the next process based on the scheduling algorithm
+ * One page of finished processes in 'sortBy' order
  */
-void Scheduler::scheduleNextProcess() {
-    if (cpu.empty() && !readyQueue.empty()) {
-        // Apply algorithm-specific sorting
-        if (algorithm == "SJF") {
-            sortBySJF();
-        } else if (algorithm == "SRTF") {
-            sortBySRTF();
-        } else if (algorithm == "Priority" || algorithm == "PriorityNP") {
-            sortByPriority();
-        }
-        // FCFS and RR use arrival order (no sorting needed)
-        
-        // Dispatch process to CPU
-        cpu.push_back(readyQueue.front());
-        readyQueue.erase(readyQueue.begin());
-        currentQuantumUsed = 0;
-        
-        // Record first execution time (for response time calculation)
-        if (cpu[0].startTime == -1) {
-            cpu[0].startTime = currentTime;
-            cpu[0].responseTime = currentTime - cpu[0].arrivalTime;
-        }
+std::vector<Process> Scheduler::getFinished(size_t offset, size_t count, const std::string& sortBy) {
+    const std::vector<uint32_t>& order = finishedOrderFor(sortBy);
+    std::vector<Process> page;
+    for (size_t i = offset; i < order.size() && page.size() < count; ++i) {
+        page.push_back(finishedProcesses[order[i]]);
     }
+    return page;
 }
 
+#ifndef SCHEDULER_NO_EXPLAIN
+namespace {
+
+const char* const BUILTIN_RULES[] = {"FCFS", "SJF", "SRTF", "RR", "Priority", "PriorityNP",
+                                     "HRRN", "HRRNP", "Expr", "ExprP", "Gang", "MLQ"};
+
 /**
- * Execute the current CPU process for one time unit
- * Updates statistics and handles process completion
+ * Decision rule name with static lifetime, so a DecisionRecord stays a flat value
+ * Built-in algorithms map to literals without locking; other names are interned
+ * in a process-wide set (sweep threads record concurrently, hence the lock)
  */
-void Scheduler::executeProcess() {
-    if (!cpu.empty()) {
-        cpu[0].remainingTime--;
-        currentQuantumUsed++;
-        
-        // Check for completion
-        if (cpu[0].remainingTime <= 0) {
-            cpu[0].completionTime = currentTime + 1;
-            cpu[0].turnaroundTime = cpu[0].completionTime - cpu[0].arrivalTime;
-            cpu[0].waitingTime = cpu[0].turnaroundTime - cpu[0].burstTime;
-            // overwrite waiting time with calculated value for redundancy
-            
-            finishedProcesses.push_back(cpu[0]);
-            cpu.clear();
-            currentQuantumUsed = 0;
-        }
+const char* ruleName(const char* name) {
+    for (const char* builtin : BUILTIN_RULES) {
+        if (std::strcmp(name, builtin) == 0) return builtin;
     }
+    static std::mutex internLock;
+    static std::unordered_set<std::string> interned;
+    std::lock_guard<std::mutex> guard(internLock);
+    return interned.insert(name).first->c_str();
+}
+
 }
+#endif
 
 /**
- * Update waiting times for all processes in ready queue
- * Called once per tick for accurate statistics
+ * Allocate the decision ring once; recording never allocates afterwards
+ * (rule names are interned, see ruleName)
+ * Clears previously recorded decisions
  */
-void Scheduler::updateWaitingTimes() {
-    for (auto& p : readyQueue) {
-        p.waitingTime++;
-    }
+void Scheduler::setExplainCapacity(size_t records) {
+#ifndef SCHEDULER_NO_EXPLAIN
+    decisionRing.assign(records, DecisionRecord());
+#else
+    (void)records;
+#endif
+    decisionStart = 0;
+    decisionCount = 0;
 }
 
 /**
- * Apply aging mechanism to prevent starvation
- * Increases priority (decreases value) for processes waiting too long
+ * Claim the next ring slot, overwriting the oldest record when full
+ * Returns before looking at 'rule' when recording is off; the plug-in rule is
+ * interned on its first recorded decision, so later ones take no lock
  */
-void Scheduler::applyAging() {
-    if (!agingEnabled || readyQueue.empty()) return;
+DecisionRecord* Scheduler::beginDecision(DecisionRecord::Kind kind, const char* rule,
+                                         int chosenId, int preemptedId) {
+#ifdef SCHEDULER_NO_EXPLAIN
+    (void)kind; (void)rule; (void)chosenId; (void)preemptedId;
+    return nullptr;
+#else
+    if (decisionRing.empty()) return nullptr;
     
-    for (auto &p : readyQueue) {
-        p.ageCounter++;
-        
-        // Apply priority boost at aging threshold
-        if (p.ageCounter >= agingThreshold) {
-            // Decrease priority value by agingBoostAmount (lower value = higher priority)
-            p.priority = std::max(0, p.priority - agingBoostAmount);
-            p.ageCounter = 0;  // Reset counter after boost
-        }
+    size_t capacity = decisionRing.size();
+    DecisionRecord& record = decisionRing[(decisionStart + decisionCount) % capacity];
+    if (decisionCount < capacity) {
+        decisionCount++;
+    } else {
+        decisionStart = (decisionStart + 1) % capacity;
     }
+    
+    record.time = currentTime;
+    record.kind = kind;
+    if (rule == policyRule.c_str()) {
+        if (!policyRuleName) policyRuleName = ruleName(rule);
+        record.rule = policyRuleName;
+    } else {
+        record.rule = ruleName(rule);
+    }
+    record.chosenId = chosenId;
+    record.preemptedId = preemptedId;
+    record.candidateTotal = 0;
+    record.candidateCount = 0;
+    return &record;
+#endif
 }
 
-/**
- * Main simulation tick - executes one time unit
- * Order of operations is critical for correct algorithm behavior
- */
-std::string Scheduler::tick() {
-    std::stringstream log;
-    log << "Time " << currentTime << ": ";
+void Scheduler::addCandidate(DecisionRecord& record, const Process& p) {
+    record.candidateTotal++;
+    if (record.candidateCount < DecisionRecord::TOP_K) {
+        record.candidates[record.candidateCount++] = {
+            p.id, p.burstTime, p.remainingTime, p.priority, p.arrivalTime
+        };
+    }
+}
 
-    // === PHASE 1: Check for new arrivals (BEFORE preemption checks) ===
-    // New arrivals join the ready queue
-    checkArrivals();
+void Scheduler::addCandidates(DecisionRecord& record, const std::vector<Process>& ranked) {
+    size_t n = std::min(ranked.size(), static_cast<size_t>(DecisionRecord::TOP_K));
+    for (size_t i = 0; i < n; ++i) {
+        addCandidate(record, ranked[i]);
+    }
+    record.candidateTotal += static_cast<int>(ranked.size() - n);
+}
 
-    // === PHASE 2: Handle preemption based on algorithm ===
+/**
+ * Up to 'count' recorded decisions from the first one at or after 'fromTime'
+ */
+std::vector<DecisionRecord> Scheduler::getDecisions(double fromTime, size_t count) const {
+    auto at = [&](size_t i) -> const DecisionRecord& {
+        return decisionRing[(decisionStart + i) % decisionRing.size()];
+    };
     
-    // Round Robin: Check quantum expiration
-    if (algorithm == "RR" && !cpu.empty() && cpu[0].remainingTime > 0) {
-        if (currentQuantumUsed >= timeQuantum) {
-            log << "Process " << cpu[0].id << " quantum expired. ";
-            preemptCPU();
-        }
+    std::vector<DecisionRecord> page;
+    for (size_t i = firstAtOrAfter(decisionCount, at, toBase(fromTime));
+         i < decisionCount && page.size() < count; ++i) {
+        page.push_back(at(i));
     }
+    return page;
+}
+
+SimTime Scheduler::getCurrentTime() const {
+    return currentTime;
+}
+
+SimTime Scheduler::getTimeResolution() const {
+    return timeResolution;
+}
+
+StateFrame Scheduler::getStateFrame() const {
+    double unit = static_cast<double>(timeResolution);
     
-    // SRTF: Check for shorter process
-    if (algorithm == "SRTF" && shouldPreemptSRTF()) {
-        auto shortestInQueue = std::min_element(readyQueue.begin(), readyQueue.end(), 
-            [](const Process& a, const Process& b){
-                return a.remainingTime < b.remainingTime;
-            });
-        log << "Process " << cpu[0].id << " preempted by Process " 
-            << shortestInQueue->id << " (SRTF). ";
-        preemptCPU();
+    int readyCount = static_cast<int>(readyQueue.size());
+    for (const auto& qc : queueClasses) {
+        readyCount += static_cast<int>(qc.readyQueue.size());
     }
     
-    // Priority (Preemptive): Check for higher priority process
-    if (algorithm == "Priority" && shouldPreemptPriority()) {
-        auto highestInQueue = std::min_element(readyQueue.begin(), readyQueue.end(), 
-            [](const Process& a, const Process& b){
-                return a.priority < b.priority;
-            });
-        log << "Process " << cpu[0].id << " preempted by Process " 
-            << highestInQueue->id << " (Priority " << highestInQueue->priority 
-            << " < " << cpu[0].priority << "). ";
-        preemptCPU();
-    }
+    StateFrame frame;
+    frame.time = currentTime / unit;
+    frame.lastExecutedId = lastExecutedId;
+    frame.cpuId = cpu.empty() ? -1 : cpu[0].id;
+    frame.cpuRemaining = cpu.empty() ? 0.0 : cpu[0].remainingTime / unit;
+    frame.readyCount = readyCount;
+    frame.finishedCount = static_cast<int>(finishedProcesses.size());
+    return frame;
+}
+
+uint32_t Scheduler::getStateVersion() const {
+    return stateVersion;
+}
+
+/**
+ * Fold one value into the state hash (splitmix64 finalizer over hash ^ value)
+ */
+void Scheduler::hashEvent(int64_t value) {
+    uint64_t z = stateHash ^ (static_cast<uint64_t>(value) + 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    stateHash = z ^ (z >> 31);
+}
+
+uint64_t Scheduler::getStateHash() const {
+    return stateHash;
+}
+
+/**
+ * Refresh the process table rows that can have changed since the last call
+ * Not-arrived and held rows only change when a process arrives, and its row is
+ * then rewritten from the container it moved to; finished rows are final. So a
+ * tick rewrites the ready, running and blocked rows plus the newly finished ones,
+ * and only addProcess/addDependency/setTimeResolution force a full rewrite
+ */
+const ProcessTable& Scheduler::syncProcessTable() {
+    if (tableVersion == stateVersion) return table;
+    tableVersion = stateVersion;
     
-    // === PHASE 3: Schedule next process if CPU is idle ===
-    scheduleNextProcess();
+    double unit = static_cast<double>(timeResolution);
+    auto put = [&](const Process& p, int32_t state, int32_t order) {
+        size_t row = static_cast<size_t>(p.slot);
+        table.ids[row] = p.id;
+        table.state[row] = state;
+        table.remaining[row] = p.remainingTime / unit;
+        table.priority[row] = p.priority;
+        table.waiting[row] = p.waitingTime / unit;
+        table.turnaround[row] = p.turnaroundTime / unit;
+        table.response[row] = p.responseTime / unit;
+        table.readyOrder[row] = order;
+    };
     
-    // === PHASE 4: Execute current process ===
-    if (!cpu.empty()) {
-        // Track what's running BEFORE execution (for accurate Gantt display)
-        lastExecutedName = cpu[0].name;
-        lastExecutedId = cpu[0].id;
-        
-        int remainingBefore = cpu[0].remainingTime;
-        log << "Running Process " << cpu[0].id << " (" << remainingBefore << " remaining). ";
-        
-        executeProcess();
-        updateWaitingTimes(); // Update stats for waiting processes
-        
-        // Check if process just finished
-        if (cpu.empty()) {
-            log << "Process " << finishedProcesses.back().id << " finished.";
-        }
-    } else {
-        lastExecutedName = "";
-        lastExecutedId = -1;
-        log << "CPU Idle.";
+    if (tableStale) {
+        tableStale = false;
+        tableFinished = 0;
+        for (const auto& p : jobPool) put(p, ProcessTable::NOT_ARRIVED, -1);
+        for (const auto& p : heldProcesses) put(p, ProcessTable::NOT_ARRIVED, -1);
+    }
+    int32_t order = 0;
+    for (const auto& p : readyQueue) put(p, ProcessTable::READY, order++);
+    for (const auto& qc : queueClasses) {
+        for (const auto& p : qc.readyQueue) put(p, ProcessTable::READY, order++);
+    }
+    for (const auto& p : cpu) put(p, ProcessTable::RUNNING, -1);
+    for (const auto& p : gangRunning) put(p, ProcessTable::RUNNING, -1);
+    for (const auto& entry : locks) {
+        for (const auto& p : entry.second.waiters) put(p, ProcessTable::BLOCKED, -1);
+    }
+    for (; tableFinished < finishedProcesses.size(); ++tableFinished) {
+        put(finishedProcesses[tableFinished], ProcessTable::FINISHED, -1);
+    }
+    return table;
+}
+
+void Scheduler::setRecordTimeline(bool enabled) {
+    recordTimeline = enabled;
+}
+
+void Scheduler::setTimelineCapacity(size_t ticks) {
+    timelineCapacity = std::max<size_t>(1, ticks);
+    if (timeline.size() > timelineCapacity) trimTimeline(timelineCapacity);
+    stateVersion++;
+}
+
+/**
+ * Drop the oldest timeline entries so that 'keep' remain
+ * Trimming to half the capacity keeps recording amortized O(1) per tick
+ */
+void Scheduler::trimTimeline(size_t keep) {
+    size_t drop = timeline.size() - std::min(keep, timeline.size());
+    timeline.erase(timeline.begin(), timeline.begin() + drop);
+    timelineStart += drop;
+}
+
+const std::vector<int32_t>& Scheduler::getTimeline() const {
+    return timeline;
+}
+
+size_t Scheduler::getTimelineStart() const {
+    return timelineStart;
+}
+
+#ifndef SCHEDULER_NO_JSON
+/**
+ * Page of finished processes: {"total", "offset", "items": [...]}
+ */
+nlohmann::json Scheduler::getFinishedJSON(size_t offset, size_t count, const std::string& sortBy) {
+    nlohmann::json j;
+    j["total"] = finishedProcesses.size();
+    j["offset"] = offset;
+    j["items"] = nlohmann::json::array();
+    for (const auto& p : getFinished(offset, count, sortBy)) {
+        j["items"].push_back({
+            {"id", p.id},
+            {"name", p.name},
+            {"arrival", toUnits(p.arrivalTime)},
+            {"burst", toUnits(p.burstTime)},
+            {"priority", p.originalPriority},
+            {"completion_time", toUnits(p.completionTime)},
+            {"waiting_time", toUnits(p.waitingTime)},
+            {"turnaround_time", toUnits(p.turnaroundTime)},
+            {"response_time", toUnits(p.responseTime)}
+        });
+    }
+    return j;
+}
+
+/**
+ * Page of retained log lines: {"retained", "entries": [{time, text}]}
+ */
+nlohmann::json Scheduler::getLogJSON(double fromTime, size_t count) const {
+    nlohmann::json j;
+    j["retained"] = logRing.size();
+    j["entries"] = nlohmann::json::array();
+    for (const auto& entry : getLog(fromTime, count)) {
+        j["entries"].push_back({{"time", toUnits(entry.time)}, {"text", entry.text}});
     }
+    return j;
+}
+
+/**
+ * Page of decision records: {"recorded", "decisions": [{time, kind, rule, chosen,
+ * preempted, candidate_total, candidates: [{id, burst, remaining, priority, arrival}]}]}
+ */
+nlohmann::json Scheduler::getDecisionsJSON(double fromTime, size_t count) const {
+    static const char* kindNames[] = {"dispatch", "preempt", "quantum_expired", "class_preempt"};
     
-    // === PHASE 5: Apply aging (end of tick) ===
-    applyAging();
-    if (agingEnabled && !readyQueue.empty()) {
-        for (const auto &p : readyQueue) {
-            if (p.ageCounter == 0 && p.priority < p.originalPriority) {
-                log << " [Aged: P" << p.id << " priority=" << p.priority << "]";
-            }
+    nlohmann::json j;
+    j["recorded"] = decisionCount;
+    j["decisions"] = nlohmann::json::array();
+    for (const auto& d : getDecisions(fromTime, count)) {
+        nlohmann::json candidates = nlohmann::json::array();
+        for (int i = 0; i < d.candidateCount; ++i) {
+            const DecisionCandidate& c = d.candidates[i];
+            candidates.push_back({
+                {"id", c.id},
+                {"burst", toUnits(c.burst)},
+                {"remaining", toUnits(c.remaining)},
+                {"priority", c.priority},
+                {"arrival", toUnits(c.arrival)}
+            });
         }
+        j["decisions"].push_back({
+            {"time", toUnits(d.time)},
+            {"kind", kindNames[d.kind]},
+            {"rule", d.rule},
+            {"chosen", d.chosenId},
+            {"preempted", d.preemptedId},
+            {"candidate_total", d.candidateTotal},
+            {"candidates", candidates}
+        });
     }
+    return j;
+}
+
+/**
+ * Current record of one process, with its state and metrics so far
+ */
+nlohmann::json Scheduler::getProcessJSON(int id) const {
+    static const char* stateNames[] = {"not_arrived", "ready", "running", "finished", "blocked"};
     
-    currentTime++;
-    return log.str();
+    const Process* p = getProcess(id);
+    if (!p) return nullptr;
+    return {
+        {"id", p->id},
+        {"name", p->name},
+        {"state", stateNames[slotWhere[p->slot]]},
+        {"arrival", toUnits(p->arrivalTime)},
+        {"burst", toUnits(p->burstTime)},
+        {"remaining", toUnits(p->remainingTime)},
+        {"priority", p->priority},
+        {"original_priority", p->originalPriority},
+        {"class", p->queueClass},
+        {"waiting_time", toUnits(p->waitingTime)},
+        {"turnaround_time", toUnits(p->turnaroundTime)},
+        {"response_time", toUnits(p->responseTime)}
+    };
 }
 
 nlohmann::json Scheduler::getStateJSON() const {
     nlohmann::json j;
-    j["time"] = currentTime;
+    j["time"] = toUnits(currentTime);
     j["algorithm"] = algorithm;
     
     if (!cpu.empty()) {
         j["cpu_process"] = {
             {"id", cpu[0].id},
             {"name", cpu[0].name},
-            {"remaining", cpu[0].remainingTime},
-            {"quantum_used", currentQuantumUsed}
+            {"remaining", toUnits(cpu[0].remainingTime)},
+            {"quantum_used", toUnits(currentQuantumUsed)}
         };
     } else {
         j["cpu_process"] = nullptr;
@@ -324,34 +2474,132 @@ nlohmann::json Scheduler::getStateJSON() const {
     }
     
     j["ready_queue"] = nlohmann::json::array();
-    for (const auto& p : readyQueue) {
-        j["ready_queue"].push_back({
-            {"id", p.id},
-            {"name", p.name},
-            {"remaining", p.remainingTime},
-            {"priority", p.priority},
-            {"age_counter", p.ageCounter}
-        });
+    auto addReady = [this, &j](const std::vector<Process>& queue) {
+        for (const auto& p : queue) {
+            j["ready_queue"].push_back({
+                {"id", p.id},
+                {"name", p.name},
+                {"remaining", toUnits(p.remainingTime)},
+                {"priority", p.priority},
+                {"age_counter", toUnits(p.ageCounter)},
+                {"class", p.queueClass}
+            });
+        }
+    };
+    addReady(readyQueue);
+    for (const auto& qc : queueClasses) {
+        addReady(qc.readyQueue);
     }
     
     j["job_pool"] = nlohmann::json::array();
-    for (const auto& p : jobPool) {
+    for (const Process* p : jobPoolInOrder()) {
         j["job_pool"].push_back({
-            {"id", p.id},
-            {"arrival", p.arrivalTime}
+            {"id", p->id},
+            {"arrival", toUnits(p->arrivalTime)}
         });
     }
     
+    DagMetrics dag;
+    if (!dagNodes.empty()) dag = getDagMetrics();
+    auto units = [this](double t) { return toUnits(std::llround(t * timeResolution)); };
+    
     j["finished"] = nlohmann::json::array();
     for (const auto& p : finishedProcesses) {
         j["finished"].push_back({
             {"id", p.id},
             {"name", p.name},
-            {"waiting_time", p.waitingTime},
-            {"turnaround_time", p.turnaroundTime},
-            {"response_time", p.responseTime}
+            {"waiting_time", toUnits(p.waitingTime)},
+            {"turnaround_time", toUnits(p.turnaroundTime)},
+            {"response_time", toUnits(p.responseTime)},
+            {"blocked_time", toUnits(p.blockedTime)},
+            {"inversion_time", toUnits(p.inversionTime)}
         });
+        if (p.predictedBurst >= 0) j["finished"].back()["predicted_burst"] = toUnits(p.predictedBurst);
+        if (!dagNodes.empty()) j["finished"].back()["slack"] = units(dag.slack[p.slot]);
+    }
+    
+    if (!dagNodes.empty()) {
+        j["dag"] = {
+            {"critical_path", units(dag.criticalPath)},
+            {"work", units(dag.work)},
+            {"makespan", units(dag.makespan)},
+            {"held", dag.held},
+            {"critical", dag.criticalIds}
+        };
     }
     
+    if (burstPredictor != "None") {
+        double n = static_cast<double>(std::max<size_t>(1, predictedCount));
+        j["prediction"] = {
+            {"predictor", burstPredictor},
+            {"predicted", predictedCount},
+            {"mean_abs_error", predictionAbsError / n / timeResolution},
+            {"mean_rel_error", predictionRelError / n}
+        };
+    }
+    
+    nlohmann::json blocked = nlohmann::json::array();
+    for (int lockId : contendedLocks) {
+        for (const auto& w : locks.at(lockId).waiters) {
+            blocked.push_back({
+                {"id", w.id},
+                {"name", w.name},
+                {"lock", lockId},
+                {"holder", locks.at(lockId).owner}
+            });
+        }
+    }
+    if (algorithm == "Gang") {
+        nlohmann::json running = nlohmann::json::array();
+        for (const auto& g : gangRunning) {
+            running.push_back({
+                {"id", g.id},
+                {"name", g.name},
+                {"remaining", toUnits(g.remainingTime)},
+                {"cores", g.assignedCores}
+            });
+        }
+        long long coreTicks = busyCoreTicks + idleCoreTicks;
+        j["gang"] = {
+            {"cores", coreCount},
+            {"core_owner", coreOwner},
+            {"running", running},
+            {"busy_core_time", toUnits(busyCoreTicks)},
+            {"idle_core_time", toUnits(idleCoreTicks)},
+            {"fragmented_core_time", toUnits(fragmentedCoreTicks)},
+            {"utilization", coreTicks > 0 ? static_cast<double>(busyCoreTicks) / coreTicks : 0.0}
+        };
+    }
+    
+    if (dvfsEnabled) {
+        nlohmann::json frequencies = nlohmann::json::array();
+        for (int level : coreFreqLevel) {
+            frequencies.push_back(frequencyStates[level].mhz);
+        }
+        // Accumulated per base tick; reported in watt-time-units so the
+        // same workload costs the same at any resolution
+        double unit = static_cast<double>(timeResolution);
+        double energy = (staticEnergy + dynamicEnergy) / unit;
+        j["energy"] = {
+            {"governor", governor},
+            {"core_mhz", frequencies},
+            {"energy", energy},
+            {"static_energy", staticEnergy / unit},
+            {"dynamic_energy", dynamicEnergy / unit},
+            {"avg_busy_mhz", dvfsBusyTicks > 0 ? static_cast<double>(frequencyTicks) / dvfsBusyTicks : 0.0},
+            {"energy_per_process", finishedProcesses.empty() ? 0.0 : energy / finishedProcesses.size()},
+            {"throughput", currentTime > 0 ? static_cast<double>(finishedProcesses.size()) * timeResolution / currentTime : 0.0}
+        };
+    }
+    
+    j["locks"] = {
+        {"protocol", lockProtocol},
+        {"blocked", blocked},
+        {"inversion_time", toUnits(inversionTicks)},
+        {"unbounded_inversion_time", toUnits(unboundedInversionTicks)},
+        {"deadlocked", deadlocked}
+    };
+    
     return j;
 }
+#endif
@@ -0,0 +1,381 @@
+#include "scheduler_c.h"
+#include "policy_plugin.h"
+#include "scenario.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * C ABI over Scheduler (see include/scheduler_c.h)
+ * Every entry point catches exceptions so none cross the boundary
+ */
+struct sched_handle {
+    Scheduler scheduler;
+    std::string error;
+    size_t processCount = 0;
+};
+
+namespace {
+
+int fail(sched_handle* h, int code, const std::string& message) {
+    h->error = message;
+    return code;
+}
+
+template <typename F>
+int guarded(sched_handle* h, F body) {
+    if (!h) return SCHED_E_INVALID_ARGUMENT;
+    try {
+        h->error.clear();
+        return body();
+    } catch (const std::exception& e) {
+        return fail(h, SCHED_E_INTERNAL, e.what());
+    } catch (...) {
+        return fail(h, SCHED_E_INTERNAL, "unknown error");
+    }
+}
+
+double toUnits(const sched_handle* h, SimTime t) {
+    return static_cast<double>(t) / static_cast<double>(h->scheduler.getTimeResolution());
+}
+
+}
+
+extern "C" {
+
+uint32_t sched_abi_version(void) {
+    return SCHED_ABI_VERSION;
+}
+
+sched_handle* sched_create(void) {
+    try {
+        return new sched_handle();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void sched_destroy(sched_handle* h) {
+    delete h;
+}
+
+const char* sched_last_error(const sched_handle* h) {
+    return h ? h->error.c_str() : "null handle";
+}
+
+int sched_set_algorithm(sched_handle* h, const char* algorithm) {
+    return guarded(h, [&] {
+        if (!algorithm || !isKnownAlgorithm(algorithm)) {
+            return fail(h, SCHED_E_UNKNOWN_ALGORITHM, std::string("unknown algorithm: ") + (algorithm ? algorithm : "(null)"));
+        }
+        h->scheduler.setAlgorithm(algorithm);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_time_quantum(sched_handle* h, double quantum) {
+    return guarded(h, [&] {
+        if (!(quantum > 0) || !std::isfinite(quantum)) {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "quantum must be positive");
+        }
+        h->scheduler.setTimeQuantum(quantum);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_aging(sched_handle* h, int enabled, double threshold, int boost) {
+    return guarded(h, [&] {
+        if (!(threshold > 0) || !std::isfinite(threshold) || boost < 0) {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "aging threshold must be positive and boost non-negative");
+        }
+        h->scheduler.setAging(enabled != 0);
+        h->scheduler.setAgingThreshold(threshold);
+        h->scheduler.setAgingBoostAmount(boost);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_time_resolution(sched_handle* h, int64_t units_per_time) {
+    return guarded(h, [&] {
+        if (units_per_time < 1) return fail(h, SCHED_E_INVALID_ARGUMENT, "time resolution must be >= 1");
+        h->scheduler.setTimeResolution(units_per_time);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_context_switch(sched_handle* h, double cost) {
+    return guarded(h, [&] {
+        if (!(cost >= 0) || !std::isfinite(cost)) {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "context switch cost must be >= 0");
+        }
+        h->scheduler.setContextSwitchCost(cost);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_priority_expression(sched_handle* h, const char* expression, int preemptive) {
+    return guarded(h, [&] {
+        if (!expression) return fail(h, SCHED_E_INVALID_ARGUMENT, "null expression");
+        std::string error = h->scheduler.setPriorityExpression(expression);
+        if (!error.empty()) return fail(h, SCHED_E_PARSE, error);
+        h->scheduler.setAlgorithm(preemptive ? "ExprP" : "Expr");
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_burst_predictor(sched_handle* h, const char* predictor, double param, double initial_guess) {
+    return guarded(h, [&] {
+        if (!predictor) return fail(h, SCHED_E_INVALID_ARGUMENT, "null predictor");
+        std::string name = predictor;
+        if (name != "None" && name != "EWMA" && name != "Quantile") {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "unknown predictor \"" + name + "\"");
+        }
+        if (!(param > 0 && param <= 1)) return fail(h, SCHED_E_INVALID_ARGUMENT, "predictor parameter must be in (0, 1]");
+        if (!(initial_guess > 0) || !std::isfinite(initial_guess)) {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "initial burst guess must be > 0");
+        }
+        h->scheduler.setBurstPredictor(name, param);
+        h->scheduler.setInitialBurstGuess(initial_guess);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_set_policy_plugin(sched_handle* h, const char* path) {
+    return guarded(h, [&] {
+        if (!path) return fail(h, SCHED_E_INVALID_ARGUMENT, "null plug-in path");
+        std::string error;
+        std::shared_ptr<PolicyInstance> policy = loadPolicy(path, error);
+        if (!policy) return fail(h, SCHED_E_PLUGIN, error);
+        h->scheduler.setPolicy(policy);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_load(sched_handle* h, size_t count, const int32_t* ids, const double* arrival,
+               const double* burst, const int32_t* priority, const char* const* names) {
+    return guarded(h, [&] {
+        if (count == 0) return static_cast<int>(SCHED_OK);
+        if (!ids || !arrival || !burst || !priority) {
+            return fail(h, SCHED_E_INVALID_ARGUMENT, "ids, arrival, burst and priority are required");
+        }
+
+        // Validate the whole batch first so a bad row adds nothing
+        SimTime unit = h->scheduler.getTimeResolution();
+        std::unordered_set<int32_t> seen;
+        seen.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::string row = "row " + std::to_string(i) + ": ";
+            if (ids[i] < 0) return fail(h, SCHED_E_INVALID_ARGUMENT, row + "negative id");
+            if (!seen.insert(ids[i]).second || h->scheduler.getProcess(ids[i])) {
+                return fail(h, SCHED_E_DUPLICATE_ID, row + "duplicate id " + std::to_string(ids[i]));
+            }
+            if (!(arrival[i] >= 0) || !std::isfinite(arrival[i])) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, row + "arrival must be >= 0");
+            }
+            if (!fitsSimTime(arrival[i], unit)) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, row + "arrival out of range at this time resolution");
+            }
+            if (!(burst[i] > 0) || !std::isfinite(burst[i])) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, row + "burst must be > 0");
+            }
+            if (!fitsSimTime(burst[i], unit)) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, row + "burst out of range at this time resolution");
+            }
+            if (std::llround(burst[i] * static_cast<double>(unit)) < 1) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, row + "burst rounds to 0 at this time resolution");
+            }
+            if (priority[i] < 0) return fail(h, SCHED_E_INVALID_ARGUMENT, row + "negative priority");
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            std::string name = names && names[i] ? names[i] : "P" + std::to_string(ids[i]);
+            h->scheduler.addProcess(ids[i], name, arrival[i], burst[i], priority[i]);
+        }
+        h->processCount += count;
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_add_dependencies(sched_handle* h, size_t count, const int32_t* parents, const int32_t* children) {
+    return guarded(h, [&] {
+        if (count == 0) return static_cast<int>(SCHED_OK);
+        if (!parents || !children) return fail(h, SCHED_E_INVALID_ARGUMENT, "parents and children are required");
+
+        // Table rows follow load order, so row numbers check "parent first"
+        const ProcessTable& t = h->scheduler.syncProcessTable();
+        std::unordered_map<int32_t, size_t> rowOf;
+        rowOf.reserve(t.ids.size());
+        for (size_t row = 0; row < t.ids.size(); ++row) rowOf.emplace(t.ids[row], row);
+        for (size_t i = 0; i < count; ++i) {
+            std::string edge = "edge " + std::to_string(i) + ": ";
+            auto parent = rowOf.find(parents[i]);
+            auto child = rowOf.find(children[i]);
+            if (parent == rowOf.end() || child == rowOf.end()) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, edge + "unknown id");
+            }
+            if (parent->second >= child->second) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, edge + "parent must be loaded before its child");
+            }
+            if (t.state[child->second] != ProcessTable::NOT_ARRIVED) {
+                return fail(h, SCHED_E_INVALID_ARGUMENT, edge + "child has already arrived");
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            h->scheduler.addDependency(parents[i], children[i]);
+        }
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_load_scenario(sched_handle* h, const char* text, size_t length) {
+    return guarded(h, [&] {
+        if (!text) return fail(h, SCHED_E_INVALID_ARGUMENT, "null scenario text");
+        Scenario scenario;
+        std::vector<ScenarioError> errors;
+        if (!parseScenario(std::string(text, length), scenario, errors)) {
+            const ScenarioError& first = errors.front();
+            return fail(h, SCHED_E_PARSE, "line " + std::to_string(first.line) + ": " + first.message +
+                                          (errors.size() > 1 ? " (+" + std::to_string(errors.size() - 1) + " more)" : ""));
+        }
+        for (const auto& p : scenario.processes) {
+            if (h->scheduler.getProcess(p.id)) {
+                return fail(h, SCHED_E_DUPLICATE_ID, "duplicate id " + std::to_string(p.id));
+            }
+        }
+        applyScenario(scenario, h->scheduler);
+        h->processCount += scenario.processes.size();
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_run_until(sched_handle* h, double until, int64_t max_ticks, sched_run_result* result) {
+    return guarded(h, [&] {
+        Scheduler& s = h->scheduler;
+        bool bounded = until >= 0;
+        SimTime limit = bounded ? static_cast<SimTime>(std::llround(until * s.getTimeResolution())) : 0;
+        int64_t ticks = 0;
+        while (!s.isFinished() && (!bounded || s.getCurrentTime() < limit) && (max_ticks <= 0 || ticks < max_ticks)) {
+            s.tick();
+            ticks++;
+        }
+        if (result) {
+            result->ticks = ticks;
+            result->time = toUnits(h, s.getCurrentTime());
+            result->finished = s.isFinished() ? 1 : 0;
+        }
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+double sched_current_time(const sched_handle* h) {
+    return h ? toUnits(h, h->scheduler.getCurrentTime()) : 0.0;
+}
+
+int sched_is_finished(const sched_handle* h) {
+    return h && h->scheduler.isFinished() ? 1 : 0;
+}
+
+size_t sched_process_count(const sched_handle* h) {
+    return h ? h->processCount : 0;
+}
+
+size_t sched_finished_count(const sched_handle* h) {
+    return h ? h->scheduler.getFinishedCount() : 0;
+}
+
+uint64_t sched_state_hash(const sched_handle* h) {
+    return h ? h->scheduler.getStateHash() : 0;
+}
+
+int sched_get_metrics(const sched_handle* ch, sched_metrics* out) {
+    sched_handle* h = const_cast<sched_handle*>(ch);
+    return guarded(h, [&] {
+        if (!out) return fail(h, SCHED_E_INVALID_ARGUMENT, "null output");
+        const auto& finished = h->scheduler.getFinishedProcesses();
+        size_t n = finished.size();
+        *out = sched_metrics();
+        out->finished_count = static_cast<int64_t>(n);
+        out->makespan = toUnits(h, h->scheduler.getCurrentTime());
+        out->throughput = out->makespan > 0 ? n / out->makespan : 0.0;
+        if (n == 0) return static_cast<int>(SCHED_OK);
+
+        auto average = [&](SimTime Process::*field, double* avg, double* max) {
+            SimTime sum = 0, most = 0;
+            for (const auto& p : finished) {
+                sum += p.*field;
+                most = std::max(most, p.*field);
+            }
+            *avg = static_cast<double>(sum) / static_cast<double>(n) /
+                   static_cast<double>(h->scheduler.getTimeResolution());
+            if (max) *max = toUnits(h, most);
+        };
+        average(&Process::waitingTime, &out->avg_waiting, nullptr);
+        average(&Process::turnaroundTime, &out->avg_turnaround, nullptr);
+        average(&Process::responseTime, &out->avg_response, &out->max_response);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int sched_get_dag_metrics(const sched_handle* ch, sched_dag_metrics* out) {
+    sched_handle* h = const_cast<sched_handle*>(ch);
+    return guarded(h, [&] {
+        if (!out) return fail(h, SCHED_E_INVALID_ARGUMENT, "null output");
+        DagMetrics dag = h->scheduler.getDagMetrics();
+        out->critical_path = dag.criticalPath;
+        out->work = dag.work;
+        out->makespan = dag.makespan;
+        out->held = static_cast<int64_t>(dag.held);
+        return static_cast<int>(SCHED_OK);
+    });
+}
+
+int64_t sched_get_finished(sched_handle* h, size_t offset, size_t count, int32_t* ids,
+                           double* arrival, double* burst, double* completion, double* waiting,
+                           double* turnaround, double* response) {
+    if (!h) return SCHED_E_INVALID_ARGUMENT;
+    const auto& finished = h->scheduler.getFinishedProcesses();
+    size_t end = offset < finished.size() ? offset + std::min(count, finished.size() - offset) : offset;
+    for (size_t i = offset; i < end; ++i) {
+        const Process& p = finished[i];
+        size_t row = i - offset;
+        if (ids) ids[row] = p.id;
+        if (arrival) arrival[row] = toUnits(h, p.arrivalTime);
+        if (burst) burst[row] = toUnits(h, p.burstTime);
+        if (completion) completion[row] = toUnits(h, p.completionTime);
+        if (waiting) waiting[row] = toUnits(h, p.waitingTime);
+        if (turnaround) turnaround[row] = toUnits(h, p.turnaroundTime);
+        if (response) response[row] = toUnits(h, p.responseTime);
+    }
+    return static_cast<int64_t>(end - offset);
+}
+
+int64_t sched_get_table(sched_handle* h, size_t offset, size_t count, int32_t* ids, int32_t* state,
+                        double* remaining, int32_t* priority, double* waiting, double* turnaround,
+                        double* response) {
+    if (!h) return SCHED_E_INVALID_ARGUMENT;
+    int64_t rows = 0;
+    int code = guarded(h, [&] {
+        const ProcessTable& t = h->scheduler.syncProcessTable();
+        size_t total = t.ids.size();
+        size_t end = offset < total ? offset + std::min(count, total - offset) : offset;
+        auto copy = [&](auto* dst, const auto& column) {
+            if (dst) std::copy(column.begin() + offset, column.begin() + end, dst);
+        };
+        if (end > offset) {
+            copy(ids, t.ids);
+            copy(state, t.state);
+            copy(remaining, t.remaining);
+            copy(priority, t.priority);
+            copy(waiting, t.waiting);
+            copy(turnaround, t.turnaround);
+            copy(response, t.response);
+        }
+        rows = static_cast<int64_t>(end - offset);
+        return static_cast<int>(SCHED_OK);
+    });
+    return code == SCHED_OK ? rows : code;
+}
+
+}
@@ -31,6 +31,12 @@ int main() {
     // Mount the directory to root
     svr.set_mount_point("/", www_dir);
 
+    // Cross-origin isolation enables SharedArrayBuffer for the simulation worker
+    svr.set_post_routing_handler([](const httplib::Request&, httplib::Response& res) {
+        res.set_header("Cross-Origin-Opener-Policy", "same-origin");
+        res.set_header("Cross-Origin-Embedder-Policy", "require-corp");
+    });
+
     // Serve index.html for root path
     svr.Get("/", [&](const httplib::Request&, httplib::Response& res) {
         std::string index_path = www_dir + "/index.html";
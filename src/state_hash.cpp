@@ -0,0 +1,161 @@
+#include "state_hash.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+const char STREAM_HEADER[] = "# scheduler-hash-stream 1";
+
+void describe(HashDivergence& d) {
+    if (!d.diverged) {
+        d.detail = "streams agree";
+    } else if (d.firstDiffer == 0) {
+        d.detail = "inputs differ (hash after setup, before the first tick)";
+    } else if (d.exact) {
+        d.detail = "state first differs after tick " + std::to_string(d.firstDiffer) + " (events at base time " +
+                   std::to_string(d.firstDiffer - 1) + ")";
+    } else {
+        d.detail = "state first differs between ticks " + std::to_string(d.lastAgree + 1) + " and " +
+                   std::to_string(d.firstDiffer);
+    }
+}
+
+}
+
+HashStream recordHashStream(const Scenario& scenario, SimTime every, SimTime from, SimTime to, SimTime maxTicks) {
+    Scheduler scheduler;
+    applyScenario(scenario, scheduler);
+    every = std::max<SimTime>(1, every);
+    auto inRange = [&](SimTime t) { return t >= from && (to < 0 || t <= to); };
+
+    // The range bounds are always sampled so refined streams line up with coarse ones
+    HashStream stream;
+    SimTime tick = 0;
+    if (inRange(0)) {
+        stream.checkpoints.push_back({0, scheduler.getStateHash()});
+        stream.finished = scheduler.isFinished();
+    }
+    while (!scheduler.isFinished() && tick < maxTicks && (to < 0 || tick < to)) {
+        scheduler.tick();
+        tick++;
+        bool last = scheduler.isFinished();
+        if (inRange(tick) && (tick % every == 0 || tick == from || tick == to || last)) {
+            stream.checkpoints.push_back({tick, scheduler.getStateHash()});
+            stream.finished = last;
+        }
+    }
+    return stream;
+}
+
+std::string formatHashStream(const HashStream& stream) {
+    std::string out = std::string(STREAM_HEADER) + "\n";
+    char line[64];
+    for (size_t i = 0; i < stream.checkpoints.size(); ++i) {
+        const HashCheckpoint& c = stream.checkpoints[i];
+        bool end = stream.finished && i + 1 == stream.checkpoints.size();
+        std::snprintf(line, sizeof(line), "%s%" PRId64 " %016" PRIx64 "\n", end ? "end " : "", c.tick, c.hash);
+        out += line;
+    }
+    return out;
+}
+
+bool parseHashStream(const std::string& text, HashStream& out, std::string& error) {
+    out = HashStream();
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        if (out.finished) {
+            error = "line " + std::to_string(lineNo) + ": checkpoint after the end line";
+            return false;
+        }
+
+        std::istringstream fields(line);
+        std::string first, hex;
+        fields >> first;
+        if (first == "end") {
+            out.finished = true;
+            fields >> first;
+        }
+        fields >> hex;
+        char* tickEnd = nullptr;
+        char* hexEnd = nullptr;
+        long long tick = std::strtoll(first.c_str(), &tickEnd, 10);
+        unsigned long long hash = std::strtoull(hex.c_str(), &hexEnd, 16);
+        if (first.empty() || *tickEnd != '\0' || hex.empty() || *hexEnd != '\0' || tick < 0 ||
+            (!out.checkpoints.empty() && tick <= out.checkpoints.back().tick)) {
+            error = "line " + std::to_string(lineNo) + ": expected '<tick> <hex hash>' with increasing ticks";
+            return false;
+        }
+        out.checkpoints.push_back({tick, hash});
+    }
+    return true;
+}
+
+HashDivergence compareHashStreams(const HashStream& a, const HashStream& b) {
+    HashDivergence d;
+    const auto& ca = a.checkpoints;
+    const auto& cb = b.checkpoints;
+    size_t i = 0, j = 0;
+    while (i < ca.size() && j < cb.size()) {
+        if (ca[i].tick < cb[j].tick) {
+            i++;
+        } else if (ca[i].tick > cb[j].tick) {
+            j++;
+        } else if (ca[i].hash == cb[j].hash) {
+            d.lastAgree = ca[i].tick;
+            i++;
+            j++;
+        } else {
+            d.diverged = true;
+            d.firstDiffer = ca[i].tick;
+            break;
+        }
+    }
+
+    // Every shared checkpoint agrees: the runs may still end at different ticks
+    if (!d.diverged && (a.finished || b.finished) && !ca.empty() && !cb.empty()) {
+        SimTime endA = a.finished ? ca.back().tick : -1;
+        SimTime endB = b.finished ? cb.back().tick : -1;
+        if (a.finished && b.finished && endA != endB) {
+            d.diverged = true;
+            d.firstDiffer = std::min(endA, endB);
+        } else if (a.finished != b.finished) {
+            // Only conclusive if the unfinished run was recorded past the other's end
+            SimTime end = a.finished ? endA : endB;
+            SimTime otherLast = a.finished ? cb.back().tick : ca.back().tick;
+            if (otherLast >= end) {
+                d.diverged = true;
+                d.firstDiffer = end;
+            }
+        }
+    }
+
+    d.exact = d.diverged && (d.firstDiffer == 0 || d.firstDiffer - d.lastAgree == 1);
+    describe(d);
+    return d;
+}
+
+HashDivergence bisectDivergence(const HashRecorder& a, const HashRecorder& b, SimTime every) {
+    HashDivergence d = compareHashStreams(a(0, -1, every), b(0, -1, every));
+    while (d.diverged && !d.exact) {
+        SimTime lo = std::max<SimTime>(0, d.lastAgree);
+        SimTime hi = d.firstDiffer;
+        SimTime step = std::max<SimTime>(1, (hi - lo) / 16);
+        HashDivergence next = compareHashStreams(a(lo, hi, step), b(lo, hi, step));
+        if (!next.diverged) {
+            // The same range agreed this time: one of the runs is nondeterministic
+            d.detail = "divergence between ticks " + std::to_string(lo + 1) + " and " + std::to_string(hi) +
+                       " did not reproduce (nondeterministic run?)";
+            return d;
+        }
+        d = next;
+    }
+    return d;
+}
@@ -0,0 +1,188 @@
+#include "sweep.h"
+#include "scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+
+SweepResult runSweepJob(const std::vector<ProcessSpec>& processes, const SweepJob& job,
+                        const std::vector<DependencySpec>& dependencies) {
+    Scheduler scheduler;
+    scheduler.setAlgorithm(job.algorithm);
+    scheduler.setTimeQuantum(job.timeQuantum);
+    scheduler.setAging(job.agingEnabled);
+    scheduler.setAgingThreshold(job.agingThreshold);
+    scheduler.setAgingBoostAmount(job.agingBoostAmount);
+    if (!job.expression.empty()) scheduler.setPriorityExpression(job.expression);
+    if (!job.predictor.empty()) scheduler.setBurstPredictor(job.predictor, job.predictorParam);
+
+    for (const auto& p : processes) {
+        scheduler.addProcess(p.id, p.name, p.arrivalTime, p.burstTime, p.priority);
+    }
+    for (const auto& d : dependencies) {
+        scheduler.addDependency(d.parent, d.child);
+    }
+
+    SweepResult result;
+    result.job = job;
+    while (!scheduler.isFinished()) {
+        scheduler.tick();
+        result.ticks++;
+    }
+
+    const auto& finished = scheduler.getFinishedProcesses();
+    double unit = static_cast<double>(scheduler.getTimeResolution());
+    if (!finished.empty()) {
+        SimTime waiting = 0, turnaround = 0, response = 0, maxResponse = 0;
+        for (const auto& p : finished) {
+            waiting += p.waitingTime;
+            turnaround += p.turnaroundTime;
+            response += p.responseTime;
+            maxResponse = std::max(maxResponse, p.responseTime);
+        }
+        double n = static_cast<double>(finished.size());
+        result.avgWaitingTime = waiting / n / unit;
+        result.avgTurnaroundTime = turnaround / n / unit;
+        result.avgResponseTime = response / n / unit;
+        result.maxResponseTime = maxResponse / unit;
+    }
+    result.makespan = scheduler.getCurrentTime() / unit;
+    result.throughput = result.makespan > 0 ? finished.size() / result.makespan : 0.0;
+    if (!dependencies.empty()) result.criticalPath = scheduler.getDagMetrics().criticalPath;
+
+    // Regret against the same job run with true bursts
+    if (!job.predictor.empty()) {
+        double error = 0;
+        for (const auto& p : finished) {
+            error += std::fabs(static_cast<double>(p.predictedBurst - p.burstTime));
+        }
+        result.predictionError = finished.empty() ? 0.0 : error / finished.size() / unit;
+        SweepJob exact = job;
+        exact.predictor.clear();
+        result.regret = result.avgWaitingTime - runSweepJob(processes, exact, dependencies).avgWaitingTime;
+    }
+    return result;
+}
+
+std::vector<SweepResult> runSweep(const std::vector<ProcessSpec>& processes,
+                                  const std::vector<SweepJob>& jobs,
+                                  int threads,
+                                  const std::vector<DependencySpec>& dependencies) {
+    std::vector<SweepResult> results(jobs.size());
+    std::atomic<size_t> next(0);
+
+    // Workers pull job indices; each job owns its own Scheduler, so no other sharing
+    auto worker = [&]() {
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            results[i] = runSweepJob(processes, jobs[i], dependencies);
+        }
+    };
+
+    int count = std::max(1, std::min(threads, static_cast<int>(jobs.size())));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < count; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+    return results;
+}
+
+nlohmann::json runSweepJSON(const nlohmann::json& request, int maxThreads) {
+    std::vector<ProcessSpec> processes;
+    for (const auto& p : request.value("processes", nlohmann::json::array())) {
+        processes.push_back({
+            p.value("id", 0),
+            p.value("name", std::string("")),
+            p.value("arrival", 0.0),
+            p.value("burst", 1.0),
+            p.value("priority", 0)
+        });
+    }
+    std::vector<DependencySpec> dependencies;
+    std::unordered_map<int, size_t> position;
+    for (size_t i = 0; i < processes.size(); ++i) position.emplace(processes[i].id, i);
+    for (const auto& d : request.value("dependencies", nlohmann::json::array())) {
+        DependencySpec edge = {d.value("parent", -1), d.value("child", -1)};
+        auto parent = position.find(edge.parent);
+        auto child = position.find(edge.child);
+        if (parent == position.end() || child == position.end() || parent->second >= child->second) {
+            return {{"error", "dependency " + std::to_string(dependencies.size()) +
+                              " needs known ids with the parent listed first"}};
+        }
+        dependencies.push_back(edge);
+    }
+
+    std::vector<SweepJob> jobs;
+    for (const auto& j : request.value("jobs", nlohmann::json::array())) {
+        SweepJob job;
+        job.algorithm = j.value("algorithm", job.algorithm);
+        job.timeQuantum = j.value("quantum", job.timeQuantum);
+        job.agingEnabled = j.value("aging", job.agingEnabled);
+        job.agingThreshold = j.value("aging_threshold", job.agingThreshold);
+        job.agingBoostAmount = j.value("aging_boost", job.agingBoostAmount);
+        job.expression = j.value("expression", job.expression);
+        if (!job.expression.empty()) {
+            PriorityExpr check;
+            std::string error;
+            if (!check.compile(job.expression, error)) {
+                return {{"error", "job " + std::to_string(jobs.size()) + " expression " + error}};
+            }
+        }
+        job.predictor = j.value("predictor", job.predictor);
+        job.predictorParam = j.value("predictor_param", job.predictorParam);
+        if (!job.predictor.empty() && job.predictor != "EWMA" && job.predictor != "Quantile") {
+            return {{"error", "job " + std::to_string(jobs.size()) + " unknown predictor \"" + job.predictor + "\""}};
+        }
+        jobs.push_back(job);
+    }
+
+    int threads = std::min(request.value("threads", maxThreads), maxThreads);
+    std::vector<SweepResult> results = runSweep(processes, jobs, threads, dependencies);
+
+    nlohmann::json out;
+    out["results"] = nlohmann::json::array();
+    for (const auto& r : results) {
+        out["results"].push_back({
+            {"algorithm", r.job.algorithm},
+            {"quantum", r.job.timeQuantum},
+            {"aging", r.job.agingEnabled},
+            {"expression", r.job.expression},
+            {"avg_waiting_time", r.avgWaitingTime},
+            {"avg_turnaround_time", r.avgTurnaroundTime},
+            {"avg_response_time", r.avgResponseTime},
+            {"max_response_time", r.maxResponseTime},
+            {"makespan", r.makespan},
+            {"throughput", r.throughput}
+        });
+        if (!r.job.predictor.empty()) {
+            out["results"].back()["predictor"] = r.job.predictor;
+            out["results"].back()["prediction_error"] = r.predictionError;
+            out["results"].back()["regret"] = r.regret;
+        }
+        if (!dependencies.empty()) out["results"].back()["critical_path"] = r.criticalPath;
+    }
+
+    // Index of the best job per metric (lowest, except throughput)
+    nlohmann::json best = nlohmann::json::object();
+    for (const char* metric : {"avg_waiting_time", "avg_turnaround_time", "avg_response_time",
+                               "max_response_time", "makespan", "throughput"}) {
+        bool higherIsBetter = std::string(metric) == "throughput";
+        int bestIndex = -1;
+        for (size_t i = 0; i < results.size(); ++i) {
+            double v = out["results"][i][metric];
+            if (bestIndex == -1) {
+                bestIndex = static_cast<int>(i);
+                continue;
+            }
+            double b = out["results"][bestIndex][metric];
+            if (higherIsBetter ? v > b : v < b) bestIndex = static_cast<int>(i);
+        }
+        best[metric] = bestIndex;
+    }
+    out["best"] = best;
+    return out;
+}
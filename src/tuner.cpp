@@ -0,0 +1,469 @@
+#include "tuner.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+const char* const METRICS[] = {
+    "avg_waiting_time", "avg_turnaround_time", "avg_response_time", "p99_response_time",
+    "max_response_time", "makespan", "throughput"
+};
+
+/**
+ * splitmix64; the tuner only needs a small deterministic stream
+ */
+struct Sampler {
+    uint64_t state;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Log-uniform integer in [lo, hi]: small values are tried as often as large ones
+    int logInt(int lo, int hi) {
+        if (hi <= lo) return lo;
+        double l = std::log(static_cast<double>(lo)), h = std::log(static_cast<double>(hi) + 1);
+        return std::min(hi, static_cast<int>(std::exp(l + uniform() * (h - l))));
+    }
+};
+
+/**
+ * Pin parameters the algorithm ignores so equivalent candidates compare equal
+ */
+SweepJob canonical(SweepJob job, const SweepJob& base) {
+    if (job.algorithm != "RR") job.timeQuantum = base.timeQuantum;
+    // Aging only changes priorities, which these never read
+    if (job.algorithm == "FCFS" || job.algorithm == "SJF" || job.algorithm == "SRTF" || job.algorithm == "RR" ||
+        job.algorithm == "HRRN" || job.algorithm == "HRRNP") {
+        job.agingEnabled = false;
+    }
+    if (!job.agingEnabled) {
+        job.agingThreshold = base.agingThreshold;
+        job.agingBoostAmount = base.agingBoostAmount;
+    }
+    return job;
+}
+
+std::tuple<std::string, double, bool, double, int> key(const SweepJob& job) {
+    return std::make_tuple(job.algorithm, job.timeQuantum, job.agingEnabled, job.agingThreshold,
+                           job.agingBoostAmount);
+}
+
+std::vector<SweepJob> sampleCandidates(const Scenario& scenario, const TuneSpace& space, const TuneOptions& options) {
+    const SweepJob& base = scenario.config;
+    std::vector<std::string> algorithms = space.algorithms;
+    if (algorithms.empty()) algorithms.push_back(base.algorithm);
+
+    std::vector<SweepJob> jobs = {base};
+    std::set<std::tuple<std::string, double, bool, double, int>> seen = {key(canonical(base, base))};
+    Sampler rng = {options.seed};
+    for (int attempt = 0; attempt < options.candidates * 20 && static_cast<int>(jobs.size()) < options.candidates;
+         ++attempt) {
+        SweepJob job = base;
+        job.algorithm = algorithms[rng.next() % algorithms.size()];
+        job.timeQuantum = rng.logInt(space.quantumMin, space.quantumMax);
+        if (space.tuneAging) job.agingEnabled = rng.next() & 1;
+        job.agingThreshold = rng.logInt(space.thresholdMin, space.thresholdMax);
+        job.agingBoostAmount = rng.logInt(space.boostMin, space.boostMax);
+        job = canonical(job, base);
+        if (seen.insert(key(job)).second) jobs.push_back(job);
+    }
+    return jobs;
+}
+
+struct Running {
+    std::unique_ptr<Scheduler> scheduler;
+    bool alive = true;
+};
+
+std::unique_ptr<Scheduler> start(const Scenario& scenario, const SweepJob& job) {
+    std::unique_ptr<Scheduler> scheduler(new Scheduler());
+    applyScenario(scenario, *scheduler);
+    scheduler->setAlgorithm(job.algorithm);
+    scheduler->setTimeQuantum(job.timeQuantum);
+    scheduler->setAging(job.agingEnabled);
+    scheduler->setAgingThreshold(job.agingThreshold);
+    scheduler->setAgingBoostAmount(job.agingBoostAmount);
+    if (!job.expression.empty()) scheduler->setPriorityExpression(job.expression);
+    return scheduler;
+}
+
+/**
+ * Metrics over every process that has arrived (rows follow scenario order)
+ */
+TuneMetrics measure(Scheduler& scheduler, const Scenario& scenario) {
+    TuneMetrics m;
+    const ProcessTable& table = scheduler.syncProcessTable();
+    double unit = static_cast<double>(scheduler.getTimeResolution());
+    double now = scheduler.getCurrentTime() / unit;
+
+    std::vector<double> response;
+    response.reserve(table.ids.size());
+    double waiting = 0, turnaround = 0;
+    size_t finished = 0;
+    for (size_t row = 0; row < table.ids.size(); ++row) {
+        if (table.state[row] == ProcessTable::NOT_ARRIVED) continue;
+        // DAG processes count from their release, not their submission
+        double arrival = scenario.dependencies.empty() ? scenario.processes[row].arrivalTime
+                       : scheduler.getProcess(table.ids[row])->arrivalTime / unit;
+        bool done = table.state[row] == ProcessTable::FINISHED;
+        finished += done ? 1 : 0;
+        waiting += table.waiting[row];
+        turnaround += done ? table.turnaround[row] : now - arrival;
+        response.push_back(table.response[row] >= 0 ? table.response[row] : now - arrival);
+    }
+
+    m.complete = scheduler.isFinished();
+    m.makespan = now;
+    m.throughput = now > 0 ? finished / now : 0.0;
+    if (response.empty()) return m;
+
+    double n = static_cast<double>(response.size());
+    m.avgWaitingTime = waiting / n;
+    m.avgTurnaroundTime = turnaround / n;
+    double sum = 0;
+    for (double r : response) sum += r;
+    m.avgResponseTime = sum / n;
+    m.maxResponseTime = *std::max_element(response.begin(), response.end());
+    // Nearest-rank percentile
+    size_t rank = static_cast<size_t>(std::ceil(0.99 * n)) - 1;
+    std::nth_element(response.begin(), response.begin() + rank, response.end());
+    m.p99ResponseTime = response[rank];
+    return m;
+}
+
+/**
+ * How far the constraints are from holding, relative to their bounds (0 = feasible)
+ */
+double violation(const TuneMetrics& m, const TuneObjective& objective) {
+    double total = 0;
+    for (const auto& c : objective.constraints) {
+        double v = tuneMetric(m, c.metric);
+        double miss = c.atLeast ? c.bound - v : v - c.bound;
+        if (miss > 0) total += miss / std::max(std::fabs(c.bound), 1e-9);
+    }
+    return total;
+}
+
+/**
+ * Objective value oriented so that lower is better
+ */
+double cost(const TuneMetrics& m, const std::string& metric, bool maximize) {
+    double v = tuneMetric(m, metric);
+    return maximize ? -v : v;
+}
+
+/**
+ * Feasible candidates first (by objective), then the least infeasible; index breaks ties
+ */
+bool ranksBefore(const TuneCandidate& a, int ia, const TuneCandidate& b, int ib, const TuneObjective& objective) {
+    if (a.feasible != b.feasible) return a.feasible;
+    double ka = a.feasible ? cost(a.metrics, objective.metric, objective.maximize) : violation(a.metrics, objective);
+    double kb = b.feasible ? cost(b.metrics, objective.metric, objective.maximize) : violation(b.metrics, objective);
+    if (ka != kb) return ka < kb;
+    return ia < ib;
+}
+
+/**
+ * Run every live candidate up to 'ticks' (-1 = completion) on a worker pool
+ */
+void runRung(const Scenario& scenario, const TuneObjective& objective, std::vector<TuneCandidate>& candidates,
+             std::vector<Running>& running, const std::vector<int>& live, int rung, long long ticks, int threads) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < live.size(); i = next++) {
+            int c = live[i];
+            Scheduler& scheduler = *running[c].scheduler;
+            while (!scheduler.isFinished() && (ticks < 0 || scheduler.getCurrentTime() < ticks)) {
+                scheduler.tick();
+            }
+            candidates[c].metrics = measure(scheduler, scenario);
+            candidates[c].rung = rung;
+            candidates[c].feasible = violation(candidates[c].metrics, objective) == 0;
+        }
+    };
+
+    int count = std::max(1, std::min(threads, static_cast<int>(live.size())));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < count; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+/**
+ * a dominates b: no worse on every dimension and better on one (costs, lower is better)
+ */
+bool dominates(const std::vector<double>& a, const std::vector<double>& b) {
+    bool better = false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] > b[i]) return false;
+        if (a[i] < b[i]) better = true;
+    }
+    return better;
+}
+
+}
+
+bool isTuneMetric(const std::string& name) {
+    for (const char* metric : METRICS) {
+        if (name == metric) return true;
+    }
+    return false;
+}
+
+double tuneMetric(const TuneMetrics& m, const std::string& name) {
+    if (name == "avg_waiting_time") return m.avgWaitingTime;
+    if (name == "avg_turnaround_time") return m.avgTurnaroundTime;
+    if (name == "avg_response_time") return m.avgResponseTime;
+    if (name == "p99_response_time") return m.p99ResponseTime;
+    if (name == "max_response_time") return m.maxResponseTime;
+    if (name == "makespan") return m.makespan;
+    if (name == "throughput") return m.throughput;
+    return 0;
+}
+
+bool parseTuneObjective(const std::string& text, TuneObjective& out, std::string& error) {
+    // Split on whitespace and commas, keeping >= and <= as their own tokens
+    std::string spaced;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if ((text[i] == '>' || text[i] == '<') && i + 1 < text.size() && text[i + 1] == '=') {
+            spaced += std::string(" ") + text[i] + "= ";
+            i++;
+        } else {
+            spaced += text[i] == ',' ? ' ' : text[i];
+        }
+    }
+    std::istringstream in(spaced);
+    std::vector<std::string> tokens;
+    for (std::string t; in >> t;) tokens.push_back(t);
+
+    TuneObjective parsed;
+    if (tokens.size() < 2 || (tokens[0] != "minimize" && tokens[0] != "maximize")) {
+        error = "expected \"minimize <metric>\" or \"maximize <metric>\"";
+        return false;
+    }
+    parsed.maximize = tokens[0] == "maximize";
+    parsed.metric = tokens[1];
+    if (!isTuneMetric(parsed.metric)) {
+        error = "unknown metric '" + parsed.metric + "'";
+        return false;
+    }
+
+    size_t i = 2;
+    if (i < tokens.size()) {
+        if (i + 1 >= tokens.size() || tokens[i] != "subject" || tokens[i + 1] != "to") {
+            error = "expected \"subject to\" after the objective";
+            return false;
+        }
+        i += 2;
+        if (i == tokens.size()) {
+            error = "expected a constraint after \"subject to\"";
+            return false;
+        }
+    }
+    for (; i < tokens.size(); i += 3) {
+        if (i + 2 >= tokens.size()) {
+            error = "incomplete constraint starting at '" + tokens[i] + "'";
+            return false;
+        }
+        TuneConstraint c;
+        c.metric = tokens[i];
+        if (!isTuneMetric(c.metric)) {
+            error = "unknown metric '" + c.metric + "'";
+            return false;
+        }
+        if (tokens[i + 1] != ">=" && tokens[i + 1] != "<=") {
+            error = "expected >= or <= after '" + c.metric + "'";
+            return false;
+        }
+        c.atLeast = tokens[i + 1] == ">=";
+        char* end = nullptr;
+        c.bound = std::strtod(tokens[i + 2].c_str(), &end);
+        if (end == tokens[i + 2].c_str() || *end != '\0') {
+            error = "bad bound '" + tokens[i + 2] + "'";
+            return false;
+        }
+        parsed.constraints.push_back(c);
+    }
+    out = parsed;
+    return true;
+}
+
+TuneResult tuneScenario(const Scenario& scenario, const TuneObjective& objective, const TuneSpace& space,
+                        const TuneOptions& options) {
+    TuneResult result;
+    std::vector<SweepJob> jobs = sampleCandidates(scenario, space, options);
+    int eta = std::max(2, options.eta);
+
+    // Rung budgets grow by eta up to a lower bound on the makespan; the last runs to completion
+    SimTime horizon = 0;
+    SimTime lastArrival = 0;
+    for (const auto& p : scenario.processes) {
+        horizon += static_cast<SimTime>(std::llround(p.burstTime * scenario.timeResolution));
+        lastArrival = std::max(lastArrival, static_cast<SimTime>(std::llround(p.arrivalTime * scenario.timeResolution)));
+    }
+    horizon = std::max(horizon, lastArrival) + 1;
+    int rungs = 1;
+    for (size_t n = jobs.size(); n > 1; n = (n + eta - 1) / eta) rungs++;
+    for (int r = 0; r < rungs - 1; ++r) {
+        double scale = std::pow(static_cast<double>(eta), rungs - 1 - r);
+        result.rungTicks.push_back(std::max<long long>(1, static_cast<long long>(horizon / scale)));
+    }
+    result.rungTicks.push_back(-1);
+
+    result.candidates.resize(jobs.size());
+    std::vector<Running> running(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        result.candidates[i].config = jobs[i];
+        running[i].scheduler = start(scenario, jobs[i]);
+    }
+
+    // Pareto dimensions: the objective and every constraint metric
+    std::vector<std::string> dims = {objective.metric};
+    std::vector<bool> maximizeDim = {objective.maximize};
+    for (const auto& c : objective.constraints) {
+        if (std::find(dims.begin(), dims.end(), c.metric) == dims.end()) {
+            dims.push_back(c.metric);
+            maximizeDim.push_back(c.atLeast);
+        }
+    }
+    auto costs = [&](int c) {
+        std::vector<double> v;
+        for (size_t d = 0; d < dims.size(); ++d) v.push_back(cost(result.candidates[c].metrics, dims[d], maximizeDim[d]));
+        return v;
+    };
+    auto front = [&](const std::vector<int>& set) {
+        std::vector<int> out;
+        for (int c : set) {
+            bool dominated = false;
+            for (int other : set) {
+                // Identical points keep only the earliest candidate
+                if (other != c && (dominates(costs(other), costs(c)) || (other < c && costs(other) == costs(c)))) {
+                    dominated = true;
+                    break;
+                }
+            }
+            if (!dominated) out.push_back(c);
+        }
+        return out;
+    };
+
+    std::vector<int> live(jobs.size());
+    for (size_t i = 0; i < live.size(); ++i) live[i] = static_cast<int>(i);
+    for (int r = 0; r < rungs; ++r) {
+        runRung(scenario, objective, result.candidates, running, live, r, result.rungTicks[r], options.threads);
+        if (r == rungs - 1) break;
+
+        // Promote the best 1/eta and the rung's Pareto front, so trade-offs the objective
+        // alone would drop reach completion; the scenario's own config always continues
+        std::vector<int> ranked = live;
+        std::sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+            return ranksBefore(result.candidates[a], a, result.candidates[b], b, objective);
+        });
+        size_t keep = std::max<size_t>(1, (ranked.size() + eta - 1) / eta);
+        std::vector<int> promoted(ranked.begin(), ranked.begin() + keep);
+        if (dims.size() > 1) {
+            for (int c : front(live)) promoted.push_back(c);
+        }
+        promoted.push_back(0);
+        std::sort(promoted.begin(), promoted.end());
+        promoted.erase(std::unique(promoted.begin(), promoted.end()), promoted.end());
+        live = promoted;
+        for (int c : ranked) {
+            if (!std::binary_search(live.begin(), live.end(), c)) running[c].scheduler.reset();
+        }
+    }
+
+    // Best and Pareto front among the candidates that ran to completion
+    std::vector<int> complete;
+    for (int c : live) {
+        if (!result.candidates[c].metrics.complete) continue;
+        complete.push_back(c);
+        if (result.candidates[c].feasible &&
+            (result.best == -1 || ranksBefore(result.candidates[c], c, result.candidates[result.best], result.best,
+                                              objective))) {
+            result.best = c;
+        }
+    }
+    result.pareto = front(complete);
+    std::sort(result.pareto.begin(), result.pareto.end(), [&](int a, int b) {
+        double ca = costs(a)[0], cb = costs(b)[0];
+        return ca != cb ? ca < cb : a < b;
+    });
+    return result;
+}
+
+nlohmann::json runTuneJSON(const nlohmann::json& request, int maxThreads) {
+    Scenario scenario;
+    std::vector<ScenarioError> errors;
+    if (!parseScenario(request.value("scenario", std::string()), scenario, errors)) {
+        return {{"error", "scenario line " + std::to_string(errors.front().line) + ": " + errors.front().message}};
+    }
+    TuneObjective objective;
+    std::string error;
+    if (!parseTuneObjective(request.value("objective", std::string("minimize avg_waiting_time")), objective, error)) {
+        return {{"error", "objective: " + error}};
+    }
+
+    TuneSpace space;
+    TuneOptions options;
+    const nlohmann::json s = request.value("space", nlohmann::json::object());
+    space.algorithms = s.value("algorithms", space.algorithms);
+    for (const auto& a : space.algorithms) {
+        if (!isKnownAlgorithm(a)) return {{"error", "unknown algorithm \"" + a + "\""}};
+    }
+    auto range = [&](const char* name, int& lo, int& hi) {
+        if (s.contains(name) && s[name].is_array() && s[name].size() == 2) {
+            lo = std::max(1, s[name][0].get<int>());
+            hi = std::max(lo, s[name][1].get<int>());
+        }
+    };
+    range("quantum", space.quantumMin, space.quantumMax);
+    range("aging_threshold", space.thresholdMin, space.thresholdMax);
+    range("aging_boost", space.boostMin, space.boostMax);
+    space.tuneAging = s.value("aging", space.tuneAging);
+    options.candidates = std::max(1, request.value("candidates", options.candidates));
+    options.eta = request.value("eta", options.eta);
+    options.seed = request.value("seed", options.seed);
+    options.threads = std::max(1, std::min(request.value("threads", maxThreads), maxThreads));
+
+    TuneResult result = tuneScenario(scenario, objective, space, options);
+    nlohmann::json out;
+    out["candidates"] = nlohmann::json::array();
+    for (const auto& c : result.candidates) {
+        nlohmann::json row = {
+            {"algorithm", c.config.algorithm},
+            {"quantum", c.config.timeQuantum},
+            {"aging", c.config.agingEnabled},
+            {"aging_threshold", c.config.agingThreshold},
+            {"aging_boost", c.config.agingBoostAmount},
+            {"rung", c.rung},
+            {"feasible", c.feasible},
+            {"complete", c.metrics.complete}
+        };
+        for (const char* metric : METRICS) row[metric] = tuneMetric(c.metrics, metric);
+        out["candidates"].push_back(row);
+    }
+    out["rung_ticks"] = result.rungTicks;
+    out["best"] = result.best;
+    out["pareto"] = result.pareto;
+    return out;
+}
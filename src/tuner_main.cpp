@@ -0,0 +1,112 @@
+#include "tuner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * Configuration tuner
+ *   scheduler_tune <scenario> [--objective TEXT] [--algorithms A,B,...] [--quantum MIN:MAX]
+ *                  [--no-aging] [--candidates N] [--eta N] [--threads N] [--seed S]
+ * Prints the best configuration and the Pareto front
+ * Exit status: 0 = a feasible configuration was found, 1 = none, 2 = usage or input error
+ */
+
+namespace {
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " <scenario> [--objective TEXT] [--algorithms A,B,...]\n"
+              << "       [--quantum MIN:MAX] [--no-aging] [--candidates N] [--eta N] [--threads N] [--seed S]\n"
+              << "  e.g. --objective \"minimize p99_response_time subject to throughput >= 0.4\"\n";
+    return 2;
+}
+
+std::string describe(const SweepJob& job) {
+    std::ostringstream out;
+    out << job.algorithm;
+    if (job.algorithm == "RR") out << " quantum=" << job.timeQuantum;
+    if (job.agingEnabled) out << " aging=" << job.agingThreshold << "/" << job.agingBoostAmount;
+    return out.str();
+}
+
+void printRow(const char* label, const TuneCandidate& c, const TuneObjective& objective) {
+    std::printf("%-9s %-28s %s=%.4g", label, describe(c.config).c_str(), objective.metric.c_str(),
+                tuneMetric(c.metrics, objective.metric));
+    for (const auto& constraint : objective.constraints) {
+        if (constraint.metric == objective.metric) continue;
+        std::printf(" %s=%.4g", constraint.metric.c_str(), tuneMetric(c.metrics, constraint.metric));
+    }
+    std::printf("%s\n", c.feasible ? "" : "  (infeasible)");
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+
+    TuneObjective objective;
+    TuneSpace space;
+    TuneOptions options;
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (opt == "--no-aging") {
+            space.tuneAging = false;
+            continue;
+        }
+        if (i + 1 >= argc) return usage(argv[0]);
+        std::string value = argv[++i];
+        if (opt == "--objective") {
+            std::string error;
+            if (!parseTuneObjective(value, objective, error)) {
+                std::cerr << "Error: objective: " << error << std::endl;
+                return 2;
+            }
+        } else if (opt == "--algorithms") {
+            std::istringstream list(value);
+            for (std::string a; std::getline(list, a, ',');) {
+                if (!isKnownAlgorithm(a)) {
+                    std::cerr << "Error: unknown algorithm \"" << a << "\"" << std::endl;
+                    return 2;
+                }
+                space.algorithms.push_back(a);
+            }
+        } else if (opt == "--quantum") {
+            if (std::sscanf(value.c_str(), "%d:%d", &space.quantumMin, &space.quantumMax) != 2 ||
+                space.quantumMin < 1 || space.quantumMax < space.quantumMin) {
+                return usage(argv[0]);
+            }
+        } else if (opt == "--candidates") options.candidates = std::max(1, std::atoi(value.c_str()));
+        else if (opt == "--eta") options.eta = std::atoi(value.c_str());
+        else if (opt == "--threads") options.threads = std::max(1, std::atoi(value.c_str()));
+        else if (opt == "--seed") options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else return usage(argv[0]);
+    }
+
+    Scenario scenario;
+    std::vector<ScenarioError> errors;
+    if (!loadScenarioFile(argv[1], scenario, errors)) {
+        for (const auto& e : errors) {
+            std::cerr << argv[1] << ":" << e.line << ": " << e.message << "\n";
+        }
+        return 2;
+    }
+
+    TuneResult result = tuneScenario(scenario, objective, space, options);
+    std::cout << result.candidates.size() << " candidates, rung budgets:";
+    for (long long ticks : result.rungTicks) {
+        if (ticks < 0) std::cout << " completion";
+        else std::cout << " " << ticks;
+    }
+    std::cout << "\n";
+
+    printRow("baseline", result.candidates[0], objective);
+    if (result.best >= 0) printRow("best", result.candidates[result.best], objective);
+    else std::cout << "No configuration satisfies the constraints\n";
+    for (int c : result.pareto) {
+        printRow("pareto", result.candidates[c], objective);
+    }
+    return result.best >= 0 ? 0 : 1;
+}
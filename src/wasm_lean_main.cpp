@@ -0,0 +1,168 @@
+#include <emscripten/emscripten.h>
+#include "scheduler.h"
+
+/**
+ * Raw C exports for the size-optimized build (no embind, no nlohmann::json)
+ * www/scheduler_lean_api.js wraps these in the same Scheduler interface as embind.
+ * Returned strings and frames live in the handle and stay valid until its next call;
+ * column pointers follow the typed-view rules of the embind getProcessTable().
+ */
+
+namespace {
+
+struct LeanScheduler {
+    Scheduler scheduler;
+    std::string text;
+    double frame[6];    // StateFrame fields, in declaration order
+    double summary[4];  // RunSummary ticks, time, finished, elapsedMs (log in text)
+};
+
+// Column ids for sched_table_column (must match scheduler_lean_api.js)
+enum TableColumn { COL_IDS, COL_STATE, COL_REMAINING, COL_PRIORITY, COL_WAITING,
+                   COL_TURNAROUND, COL_RESPONSE, COL_READY_ORDER };
+
+}  // namespace
+
+extern "C" {
+
+EMSCRIPTEN_KEEPALIVE LeanScheduler* sched_create() {
+    return new LeanScheduler();
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_destroy(LeanScheduler* h) {
+    delete h;
+}
+
+EMSCRIPTEN_KEEPALIVE int sched_add_process(LeanScheduler* h, int id, const char* name,
+                                           double arrivalTime, double burstTime, int priority) {
+    return h->scheduler.addProcess(id, name, arrivalTime, burstTime, priority) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE int sched_add_dependency(LeanScheduler* h, int parentId, int childId) {
+    return h->scheduler.addDependency(parentId, childId) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_time_resolution(LeanScheduler* h, double unitsPerTime) {
+    h->scheduler.setTimeResolution(static_cast<SimTime>(unitsPerTime));
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_context_switch_cost(LeanScheduler* h, double cost) {
+    h->scheduler.setContextSwitchCost(cost);
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_algorithm(LeanScheduler* h, const char* algo) {
+    h->scheduler.setAlgorithm(algo);
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_time_quantum(LeanScheduler* h, double q) {
+    h->scheduler.setTimeQuantum(q);
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_aging(LeanScheduler* h, int enabled) {
+    h->scheduler.setAging(enabled != 0);
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_aging_threshold(LeanScheduler* h, double threshold) {
+    h->scheduler.setAgingThreshold(threshold);
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_aging_boost_amount(LeanScheduler* h, int amount) {
+    h->scheduler.setAgingBoostAmount(amount);
+}
+
+EMSCRIPTEN_KEEPALIVE const char* sched_set_priority_expression(LeanScheduler* h, const char* text) {
+    h->text = h->scheduler.setPriorityExpression(text);
+    return h->text.c_str();
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_burst_predictor(LeanScheduler* h, const char* predictor, double param) {
+    h->scheduler.setBurstPredictor(predictor, param);
+}
+
+EMSCRIPTEN_KEEPALIVE const char* sched_tick(LeanScheduler* h) {
+    h->text = h->scheduler.tick();
+    return h->text.c_str();
+}
+
+/**
+ * runFor(); the summary is read from sched_run_summary() and the log from the return value
+ */
+EMSCRIPTEN_KEEPALIVE const char* sched_run_for(LeanScheduler* h, double budgetMs, int maxTicks) {
+    RunSummary s = h->scheduler.runFor(budgetMs, maxTicks);
+    h->summary[0] = s.ticks;
+    h->summary[1] = s.time;
+    h->summary[2] = s.finished ? 1 : 0;
+    h->summary[3] = s.elapsedMs;
+    h->text = std::move(s.log);
+    return h->text.c_str();
+}
+
+EMSCRIPTEN_KEEPALIVE const double* sched_run_summary(LeanScheduler* h) {
+    return h->summary;
+}
+
+EMSCRIPTEN_KEEPALIVE int sched_is_finished(LeanScheduler* h) {
+    return h->scheduler.isFinished() ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE const double* sched_get_state_frame(LeanScheduler* h) {
+    StateFrame f = h->scheduler.getStateFrame();
+    h->frame[0] = f.time;
+    h->frame[1] = f.lastExecutedId;
+    h->frame[2] = f.cpuId;
+    h->frame[3] = f.cpuRemaining;
+    h->frame[4] = f.readyCount;
+    h->frame[5] = f.finishedCount;
+    return h->frame;
+}
+
+EMSCRIPTEN_KEEPALIVE unsigned sched_get_state_version(LeanScheduler* h) {
+    return h->scheduler.getStateVersion();
+}
+
+/**
+ * Bring the process table up to date; returns its row count
+ */
+EMSCRIPTEN_KEEPALIVE int sched_sync_table(LeanScheduler* h) {
+    return static_cast<int>(h->scheduler.syncProcessTable().ids.size());
+}
+
+/**
+ * Start of one column of the table last synced (int32 or double, see TableColumn)
+ */
+EMSCRIPTEN_KEEPALIVE const void* sched_table_column(LeanScheduler* h, int column) {
+    const ProcessTable& t = h->scheduler.syncProcessTable();
+    switch (column) {
+        case COL_IDS: return t.ids.data();
+        case COL_STATE: return t.state.data();
+        case COL_REMAINING: return t.remaining.data();
+        case COL_PRIORITY: return t.priority.data();
+        case COL_WAITING: return t.waiting.data();
+        case COL_TURNAROUND: return t.turnaround.data();
+        case COL_RESPONSE: return t.response.data();
+        case COL_READY_ORDER: return t.readyOrder.data();
+    }
+    return nullptr;
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_record_timeline(LeanScheduler* h, int enabled) {
+    h->scheduler.setRecordTimeline(enabled != 0);
+}
+
+EMSCRIPTEN_KEEPALIVE const int32_t* sched_timeline_data(LeanScheduler* h) {
+    return h->scheduler.getTimeline().data();
+}
+
+EMSCRIPTEN_KEEPALIVE int sched_timeline_size(LeanScheduler* h) {
+    return static_cast<int>(h->scheduler.getTimeline().size());
+}
+
+EMSCRIPTEN_KEEPALIVE void sched_set_timeline_capacity(LeanScheduler* h, int ticks) {
+    h->scheduler.setTimelineCapacity(static_cast<size_t>(ticks));
+}
+
+EMSCRIPTEN_KEEPALIVE double sched_timeline_start(LeanScheduler* h) {
+    return static_cast<double>(h->scheduler.getTimelineStart());
+}
+
+}  // extern "C"
@@ -1,5 +1,9 @@
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <cstdio>
 #include "scheduler.h"
+#include "scenario.h"
+#include "workloads.h"
 
 using namespace emscripten;
 
@@ -10,16 +14,168 @@ std::string getStateJSONString(Scheduler& self) {
     return self.getStateJSON().dump();
 }
 
+std::string getFinishedJSONString(Scheduler& self, size_t offset, size_t count, std::string sortBy) {
+    return self.getFinishedJSON(offset, count, sortBy).dump();
+}
+
+std::string getLogJSONString(Scheduler& self, double fromTime, size_t count) {
+    return self.getLogJSON(fromTime, count).dump();
+}
+
+std::string getDecisionsJSONString(Scheduler& self, double fromTime, size_t count) {
+    return self.getDecisionsJSON(fromTime, count).dump();
+}
+
+std::string getProcessJSONString(Scheduler& self, int id) {
+    return self.getProcessJSON(id).dump();
+}
+
+std::string getProcessIdsByNameJSON(Scheduler& self, std::string name) {
+    return nlohmann::json(self.getProcessIdsByName(name)).dump();
+}
+
+/**
+ * Validate a text scenario; errors carry line numbers for display
+ */
+std::string parseScenarioString(std::string text) {
+    return parseScenarioJSON(text).dump();
+}
+
+std::string listWorkloadsString() {
+    return listWorkloadsJSON().dump();
+}
+
+/**
+ * Benchmark workload as scenario text (empty for an unknown name)
+ * The seed is a JS number; integers up to 2^53 are exact
+ */
+std::string generateWorkloadString(std::string name, double count, double seed) {
+    Scenario scenario;
+    if (count < 1 || !generateWorkload(name, static_cast<size_t>(count), static_cast<uint64_t>(seed), scenario)) {
+        return "";
+    }
+    return formatScenario(scenario);
+}
+
+/**
+ * "" if the priority expression compiles, otherwise the error (with its column)
+ */
+std::string checkPriorityExpression(std::string text) {
+    PriorityExpr expr;
+    std::string error;
+    expr.compile(text, error);
+    return error;
+}
+
+/**
+ * 64-bit state hash as 16 hex digits (the hash stream format; no BigInt needed)
+ */
+std::string getStateHashHex(Scheduler& self) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(self.getStateHash()));
+    return hex;
+}
+
+/**
+ * SimTime is 64-bit; take a JS number to avoid requiring BigInt support
+ */
+void setTimeResolutionNumber(Scheduler& self, double unitsPerTime) {
+    self.setTimeResolution(static_cast<SimTime>(unitsPerTime));
+}
+
+/**
+ * Typed-array views straight into the engine's process table (no copy)
+ * The views alias WASM memory: use them before the next tick()/addProcess() and
+ * re-fetch whenever getStateVersion() changes (vectors and memory may move)
+ */
+val getProcessTableViews(Scheduler& self) {
+    const ProcessTable& t = self.syncProcessTable();
+    val views = val::object();
+    views.set("version", self.getStateVersion());
+    views.set("ids", val(typed_memory_view(t.ids.size(), t.ids.data())));
+    views.set("state", val(typed_memory_view(t.state.size(), t.state.data())));
+    views.set("remaining", val(typed_memory_view(t.remaining.size(), t.remaining.data())));
+    views.set("priority", val(typed_memory_view(t.priority.size(), t.priority.data())));
+    views.set("waiting", val(typed_memory_view(t.waiting.size(), t.waiting.data())));
+    views.set("turnaround", val(typed_memory_view(t.turnaround.size(), t.turnaround.data())));
+    views.set("response", val(typed_memory_view(t.response.size(), t.response.data())));
+    views.set("readyOrder", val(typed_memory_view(t.readyOrder.size(), t.readyOrder.data())));
+    return views;
+}
+
+/**
+ * lastExecutedId of the recorded ticks (from getTimelineStart()), as an Int32Array view
+ */
+val getTimelineView(Scheduler& self) {
+    const std::vector<int32_t>& timeline = self.getTimeline();
+    return val(typed_memory_view(timeline.size(), timeline.data()));
+}
+
 EMSCRIPTEN_BINDINGS(scheduler_module) {
+    function("parseScenario", &parseScenarioString);
+    function("listWorkloads", &listWorkloadsString);
+    function("generateWorkload", &generateWorkloadString);
+    function("checkPriorityExpression", &checkPriorityExpression);
+    
+    value_object<StateFrame>("StateFrame")
+        .field("time", &StateFrame::time)
+        .field("lastExecutedId", &StateFrame::lastExecutedId)
+        .field("cpuId", &StateFrame::cpuId)
+        .field("cpuRemaining", &StateFrame::cpuRemaining)
+        .field("readyCount", &StateFrame::readyCount)
+        .field("finishedCount", &StateFrame::finishedCount);
+    
+    value_object<RunSummary>("RunSummary")
+        .field("ticks", &RunSummary::ticks)
+        .field("time", &RunSummary::time)
+        .field("finished", &RunSummary::finished)
+        .field("elapsedMs", &RunSummary::elapsedMs)
+        .field("log", &RunSummary::log);
+    
     class_<Scheduler>("Scheduler")
         .constructor<>()
+        .function("setTimeResolution", &setTimeResolutionNumber)
+        .function("setContextSwitchCost", &Scheduler::setContextSwitchCost)
         .function("addProcess", &Scheduler::addProcess)
+        .function("addDependency", &Scheduler::addDependency)
         .function("setAlgorithm", &Scheduler::setAlgorithm)
         .function("setTimeQuantum", &Scheduler::setTimeQuantum)
         .function("setAging", &Scheduler::setAging)
         .function("setAgingThreshold", &Scheduler::setAgingThreshold)
         .function("setAgingBoostAmount", &Scheduler::setAgingBoostAmount)
+        .function("setPriorityExpression", &Scheduler::setPriorityExpression)
+        .function("addQueueClass", &Scheduler::addQueueClass)
+        .function("setInterQueuePolicy", &Scheduler::setInterQueuePolicy)
+        .function("setProcessClass", &Scheduler::setProcessClass)
+        .function("addLockRequest", &Scheduler::addLockRequest)
+        .function("setLockProtocol", &Scheduler::setLockProtocol)
+        .function("setCoreCount", &Scheduler::setCoreCount)
+        .function("setProcessThreads", &Scheduler::setProcessThreads)
+        .function("setDVFS", &Scheduler::setDVFS)
+        .function("addFrequencyState", &Scheduler::addFrequencyState)
+        .function("setGovernor", &Scheduler::setGovernor)
+        .function("setPowerModel", &Scheduler::setPowerModel)
+        .function("setReferenceFrequency", &Scheduler::setReferenceFrequency)
+        .function("setBurstPredictor", &Scheduler::setBurstPredictor)
+        .function("setInitialBurstGuess", &Scheduler::setInitialBurstGuess)
         .function("tick", &Scheduler::tick)
+        .function("runFor", &Scheduler::runFor)
         .function("isFinished", &Scheduler::isFinished)
-        .function("getStateJSON", &getStateJSONString);
+        .function("getStateJSON", &getStateJSONString)
+        .function("getStateFrame", &Scheduler::getStateFrame)
+        .function("setLogCapacity", &Scheduler::setLogCapacity)
+        .function("getFinishedCount", &Scheduler::getFinishedCount)
+        .function("getFinished", &getFinishedJSONString)
+        .function("getLog", &getLogJSONString)
+        .function("getProcess", &getProcessJSONString)
+        .function("getProcessIdsByName", &getProcessIdsByNameJSON)
+        .function("setExplainCapacity", &Scheduler::setExplainCapacity)
+        .function("getDecisions", &getDecisionsJSONString)
+        .function("getStateVersion", &Scheduler::getStateVersion)
+        .function("getStateHash", &getStateHashHex)
+        .function("setRecordTimeline", &Scheduler::setRecordTimeline)
+        .function("setTimelineCapacity", &Scheduler::setTimelineCapacity)
+        .function("getTimelineStart", &Scheduler::getTimelineStart)
+        .function("getProcessTable", &getProcessTableViews)
+        .function("getTimeline", &getTimelineView);
 }
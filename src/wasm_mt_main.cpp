@@ -0,0 +1,44 @@
+#include <emscripten/bind.h>
+#include "sweep.h"
+#include "tuner.h"
+
+using namespace emscripten;
+
+// Must match -sPTHREAD_POOL_SIZE: jobs run on pre-spawned workers so the
+// calling thread never waits for a worker to be created
+#ifndef SCHEDULER_MT_POOL_SIZE
+#define SCHEDULER_MT_POOL_SIZE 4
+#endif
+
+/**
+ * Run a sweep described as JSON and return aggregate results as JSON
+ */
+std::string runSweepString(std::string request) {
+    nlohmann::json req = nlohmann::json::parse(request, nullptr, false);
+    if (req.is_discarded()) {
+        return "{\"error\":\"invalid request JSON\"}";
+    }
+    // The calling thread is one of the workers
+    return runSweepJSON(req, SCHEDULER_MT_POOL_SIZE + 1).dump();
+}
+
+/**
+ * Tune a scenario's configuration for an objective (see tuner.h for the request)
+ */
+std::string runTuneString(std::string request) {
+    nlohmann::json req = nlohmann::json::parse(request, nullptr, false);
+    if (req.is_discarded()) {
+        return "{\"error\":\"invalid request JSON\"}";
+    }
+    return runTuneJSON(req, SCHEDULER_MT_POOL_SIZE + 1).dump();
+}
+
+int getWorkerCount() {
+    return SCHEDULER_MT_POOL_SIZE + 1;
+}
+
+EMSCRIPTEN_BINDINGS(scheduler_mt_module) {
+    function("runSweep", &runSweepString);
+    function("tune", &runTuneString);
+    function("getWorkerCount", &getWorkerCount);
+}
@@ -0,0 +1,214 @@
+#include "workloads.h"
+#include <cmath>
+
+namespace {
+
+/**
+ * splitmix64: small, fast and identical on every platform
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Uniform integer in [lo, hi]
+    long long between(long long lo, long long hi) {
+        return lo + static_cast<long long>(next() % static_cast<uint64_t>(hi - lo + 1));
+    }
+
+    double exponential(double mean) {
+        return -mean * std::log1p(-uniform());
+    }
+
+    /**
+     * Bounded Pareto on [lo, hi] with shape 'alpha' (inverse CDF)
+     */
+    double boundedPareto(double alpha, double lo, double hi) {
+        double ratio = std::pow(lo / hi, alpha);
+        return lo / std::pow(1.0 - uniform() * (1.0 - ratio), 1.0 / alpha);
+    }
+
+private:
+    uint64_t state;
+};
+
+void add(Scenario& s, const char* name, double arrival, double burst, int priority) {
+    int id = static_cast<int>(s.processes.size()) + 1;
+    s.processes.push_back({id, name, arrival, burst, priority});
+}
+
+/**
+ * FCFS convoy: every 10th job is a long CPU-bound job that arrives just ahead
+ * of nine short ones, which then queue behind it
+ */
+void convoy(Scenario& s, size_t count, Rng& rng) {
+    const double GROUP_PERIOD = 180;  // ~ one group's work, keeping the CPU ~95% busy
+    for (size_t i = 0; i < count; ++i) {
+        double groupStart = static_cast<double>(i / 10) * GROUP_PERIOD;
+        if (i % 10 == 0) {
+            add(s, "long", groupStart, static_cast<double>(rng.between(100, 200)), 0);
+        } else {
+            add(s, "short", groupStart + 1 + rng.between(0, 4), static_cast<double>(rng.between(1, 3)), 0);
+        }
+    }
+}
+
+/**
+ * Priority without aging: every 10th job is a low-priority "victim"; the rest
+ * are high-priority jobs arriving back to back, so the CPU never frees up for
+ * the victims until the stream ends
+ */
+void starvation(Scenario& s, size_t count, Rng& rng) {
+    double streamTime = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 10 == 0) {
+            add(s, "victim", streamTime, static_cast<double>(rng.between(5, 20)),
+                static_cast<int>(rng.between(5, 9)));
+        } else {
+            double burst = static_cast<double>(rng.between(1, 2));
+            add(s, "stream", streamTime, burst, static_cast<int>(rng.between(0, 1)));
+            streamTime += burst;
+        }
+    }
+}
+
+/**
+ * RR quantum thrash: waves of equal CPU-bound jobs under quantum 1 with a
+ * context switch of 1, so about half of all time goes to switching
+ */
+void rrThrash(Scenario& s, size_t count, Rng& rng) {
+    s.config.timeQuantum = 1;
+    s.contextSwitchCost = 1;
+    const double WAVE_PERIOD = 3000;  // 50 jobs x ~30 work, doubled by switching
+    for (size_t i = 0; i < count; ++i) {
+        double waveStart = static_cast<double>(i / 50) * WAVE_PERIOD;
+        add(s, "job", waveStart + rng.between(0, 9), static_cast<double>(rng.between(20, 40)), 0);
+    }
+}
+
+/**
+ * Web-like traffic: Poisson arrivals at 90% load and bounded-Pareto service
+ * times (shape 1.1 on [1, 10000]): most requests are tiny, a few are huge
+ */
+void heavyTailed(Scenario& s, size_t count, Rng& rng) {
+    const double ALPHA = 1.1, LO = 1, HI = 10000, LOAD = 0.9;
+    double mean = std::pow(LO, ALPHA) / (1 - std::pow(LO / HI, ALPHA)) * ALPHA / (ALPHA - 1) *
+                  (1 / std::pow(LO, ALPHA - 1) - 1 / std::pow(HI, ALPHA - 1));
+    double t = 0;
+    for (size_t i = 0; i < count; ++i) {
+        add(s, "request", std::floor(t), std::ceil(rng.boundedPareto(ALPHA, LO, HI)), 0);
+        t += rng.exponential(mean / LOAD);
+    }
+}
+
+/**
+ * Mixed load at 85%: 80% short interactive jobs (priority 0) and 20% long
+ * batch jobs (priority 5) with Poisson arrivals
+ */
+void batchInteractive(Scenario& s, size_t count, Rng& rng) {
+    s.config.timeQuantum = 4;
+    const double MEAN_BURST = 0.8 * 2 + 0.2 * 275, LOAD = 0.85;
+    double t = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (rng.uniform() < 0.8) {
+            add(s, "interactive", std::floor(t), static_cast<double>(rng.between(1, 3)), 0);
+        } else {
+            add(s, "batch", std::floor(t), static_cast<double>(rng.between(50, 500)), 5);
+        }
+        t += rng.exponential(MEAN_BURST / LOAD);
+    }
+}
+
+/**
+ * ETL workflows at 85% load: each pipeline is extract -> 2..6 parallel
+ * transforms of very uneven length -> join -> load, and a stage arrives only
+ * when its parents finish. Pipelines arrive as a Poisson stream, so stages of
+ * different pipelines compete and a ready-order policy delays critical paths
+ */
+void pipeline(Scenario& s, size_t count, Rng& rng) {
+    const double MEAN_WORK = 4 + 4 * 10.5 + 2 + 3.5, LOAD = 0.85;
+    double t = 0;
+    while (s.processes.size() < count) {
+        double arrival = std::floor(t);
+        int extract = static_cast<int>(s.processes.size()) + 1;
+        add(s, "extract", arrival, static_cast<double>(rng.between(2, 6)), 0);
+        std::vector<int> transforms;
+        long long width = rng.between(2, 6);
+        for (long long i = 0; i < width && s.processes.size() < count; ++i) {
+            transforms.push_back(static_cast<int>(s.processes.size()) + 1);
+            add(s, "transform", arrival, static_cast<double>(rng.between(1, 20)), 0);
+            s.dependencies.push_back({extract, transforms.back()});
+        }
+        if (s.processes.size() < count) {
+            int join = static_cast<int>(s.processes.size()) + 1;
+            add(s, "join", arrival, static_cast<double>(rng.between(1, 3)), 0);
+            for (int transform : transforms) s.dependencies.push_back({transform, join});
+            if (s.processes.size() < count) {
+                add(s, "load", arrival, static_cast<double>(rng.between(2, 5)), 0);
+                s.dependencies.push_back({join, join + 1});
+            }
+        }
+        t += rng.exponential(MEAN_WORK / LOAD);
+    }
+}
+
+struct Generator {
+    WorkloadInfo info;
+    void (*generate)(Scenario&, size_t, Rng&);
+};
+
+const std::vector<Generator>& generators() {
+    static const std::vector<Generator> all = {
+        {{"convoy", "Long CPU-bound jobs ahead of bursts of short jobs", "FCFS"}, convoy},
+        {{"starvation", "Low-priority jobs behind a saturating high-priority stream", "Priority"}, starvation},
+        {{"rr-thrash", "CPU-bound waves under quantum 1 with costly context switches", "RR"}, rrThrash},
+        {{"heavy-tailed", "Poisson arrivals with bounded-Pareto service times", "SRTF"}, heavyTailed},
+        {{"batch-interactive", "Short interactive jobs mixed with long batch jobs", "RR"}, batchInteractive},
+        {{"pipeline", "Fork-join ETL workflows whose stages wait on their parents", "FCFS"}, pipeline},
+    };
+    return all;
+}
+
+}
+
+const std::vector<WorkloadInfo>& listWorkloads() {
+    static const std::vector<WorkloadInfo> infos = [] {
+        std::vector<WorkloadInfo> v;
+        for (const auto& g : generators()) v.push_back(g.info);
+        return v;
+    }();
+    return infos;
+}
+
+bool generateWorkload(const std::string& name, size_t count, uint64_t seed, Scenario& out) {
+    if (count == 0) return false;
+    for (const auto& g : generators()) {
+        if (g.info.name != name) continue;
+        out = Scenario();
+        out.config.algorithm = g.info.algorithm;
+        out.processes.reserve(count);
+        Rng rng(seed);
+        g.generate(out, count, rng);
+        return true;
+    }
+    return false;
+}
+
+nlohmann::json listWorkloadsJSON() {
+    nlohmann::json out = nlohmann::json::array();
+    for (const auto& w : listWorkloads()) {
+        out.push_back({{"name", w.name}, {"description", w.description}, {"algorithm", w.algorithm}});
+    }
+    return out;
+}
@@ -0,0 +1,62 @@
+#include "workloads.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/**
+ * Write benchmark workloads as scenario files
+ *   scheduler_workloads list
+ *   scheduler_workloads <name> <count> [--seed N] [--binary] [-o FILE]
+ * Without -o the scenario goes to stdout
+ */
+int main(int argc, char** argv) {
+    if (argc == 2 && std::strcmp(argv[1], "list") == 0) {
+        for (const auto& w : listWorkloads()) {
+            std::cout << w.name << " (" << w.algorithm << "): " << w.description << "\n";
+        }
+        return 0;
+    }
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " list\n"
+                  << "       " << argv[0] << " <name> <count> [--seed N] [--binary] [-o FILE]\n";
+        return 2;
+    }
+
+    std::string name = argv[1];
+    size_t count = std::strtoull(argv[2], nullptr, 10);
+    uint64_t seed = WORKLOAD_DEFAULT_SEED;
+    bool binary = false;
+    std::string path;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    Scenario scenario;
+    if (!generateWorkload(name, count, seed, scenario)) {
+        std::cerr << "Unknown workload '" << name << "' or zero count (see '" << argv[0] << " list')" << std::endl;
+        return 1;
+    }
+
+    std::string data = binary ? formatScenarioBinary(scenario) : formatScenario(scenario);
+    if (path.empty()) {
+        std::cout.write(data.data(), data.size());
+        return std::cout ? 0 : 1;
+    }
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), data.size());
+    if (!file) {
+        std::cerr << "Error: could not write " << path << std::endl;
+        return 1;
+    }
+    return 0;
+}
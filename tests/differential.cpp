@@ -0,0 +1,213 @@
+#include "differential.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+Trace collectTrace(const Scheduler& scheduler, bool truncated) {
+    Trace trace;
+    trace.timeline = scheduler.getTimeline();
+    for (const auto& p : scheduler.getFinishedProcesses()) {
+        trace.finished.push_back({p.id, p.completionTime, p.waitingTime, p.turnaroundTime,
+                                  p.responseTime, p.priority});
+    }
+    trace.endTime = scheduler.getCurrentTime();
+    trace.stateHash = scheduler.getStateHash();
+    trace.truncated = truncated;
+    return trace;
+}
+
+Trace runReference(const Scenario& scenario) {
+    Scheduler scheduler;
+    scheduler.setRecordTimeline(true);
+    applyScenario(scenario, scheduler);
+    int ticks = 0;
+    while (!scheduler.isFinished() && ticks < DIFF_MAX_TICKS) {
+        scheduler.tick();
+        ticks++;
+    }
+    return collectTrace(scheduler, !scheduler.isFinished());
+}
+
+std::string compareTraces(const Trace& expected, const Trace& actual) {
+    if (expected.truncated != actual.truncated) {
+        return std::string(expected.truncated ? "reference" : "engine") + " hit the tick cap";
+    }
+    size_t ticks = std::min(expected.timeline.size(), actual.timeline.size());
+    for (size_t t = 0; t < ticks; ++t) {
+        if (expected.timeline[t] != actual.timeline[t]) {
+            return "tick " + std::to_string(t) + ": expected process " + std::to_string(expected.timeline[t]) +
+                   ", ran " + std::to_string(actual.timeline[t]);
+        }
+    }
+    if (expected.timeline.size() != actual.timeline.size()) {
+        return "timeline length " + std::to_string(expected.timeline.size()) + " vs " +
+               std::to_string(actual.timeline.size());
+    }
+    if (expected.finished.size() != actual.finished.size()) {
+        return "finished count " + std::to_string(expected.finished.size()) + " vs " +
+               std::to_string(actual.finished.size());
+    }
+    for (size_t i = 0; i < expected.finished.size(); ++i) {
+        const Outcome& e = expected.finished[i];
+        const Outcome& a = actual.finished[i];
+        std::string field;
+        if (e.id != a.id) field = "id";
+        else if (e.completion != a.completion) field = "completion";
+        else if (e.waiting != a.waiting) field = "waiting";
+        else if (e.turnaround != a.turnaround) field = "turnaround";
+        else if (e.response != a.response) field = "response";
+        else if (e.priority != a.priority) field = "priority";
+        if (!field.empty()) {
+            return "finished #" + std::to_string(i) + " (process " + std::to_string(e.id) + "): " +
+                   field + " differs";
+        }
+    }
+    if (expected.endTime != actual.endTime) {
+        return "end time " + std::to_string(expected.endTime) + " vs " + std::to_string(actual.endTime);
+    }
+    if (expected.stateHash != actual.stateHash) {
+        return "state hash differs";
+    }
+    return "";
+}
+
+Scenario randomScenario(uint64_t seed, const std::vector<std::string>& algorithms) {
+    // mt19937_64 output is fully specified; only modulo reductions are used on it
+    std::mt19937_64 rng(seed);
+    auto pick = [&](int lo, int hi) { return lo + static_cast<int>(rng() % static_cast<uint64_t>(hi - lo + 1)); };
+
+    Scenario s;
+    s.config.algorithm = algorithms[rng() % algorithms.size()];
+    s.config.timeQuantum = pick(1, 4);
+    s.config.agingEnabled = pick(0, 1) == 1;
+    s.config.agingThreshold = pick(1, 6);
+    s.config.agingBoostAmount = pick(1, 3);
+    s.contextSwitchCost = pick(0, 3) == 0 ? 1 : 0;
+
+    // Narrow ranges make ties common; ids are shuffled and sparse
+    int count = pick(1, 12);
+    int arrivalSpan = pick(0, 10);
+    std::vector<int> ids(count);
+    for (int i = 0, id = 0; i < count; ++i) ids[i] = id += pick(1, 3);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (int i = 0; i < count; ++i) {
+        s.processes.push_back({ids[i], "P" + std::to_string(ids[i]), static_cast<double>(pick(0, arrivalSpan)),
+                               static_cast<double>(pick(1, 8)), pick(0, 4)});
+    }
+    return s;
+}
+
+namespace {
+
+/**
+ * Candidate values for one field, smallest first
+ */
+std::vector<double> simpler(double value, double floor) {
+    std::vector<double> out;
+    if (value > floor) out.push_back(floor);
+    double half = std::floor((value + floor) / 2);
+    if (half > floor && half < value) out.push_back(half);
+    if (value - 1 > floor) out.push_back(value - 1);
+    return out;
+}
+
+}
+
+Scenario shrinkScenario(const Scenario& failing, const std::function<bool(const Scenario&)>& fails) {
+    Scenario best = failing;
+    const int MAX_ATTEMPTS = 5000;
+    int attempts = 0;
+    auto tryCandidate = [&](const Scenario& candidate) {
+        if (attempts >= MAX_ATTEMPTS) return false;
+        attempts++;
+        if (!fails(candidate)) return false;
+        best = candidate;
+        return true;
+    };
+
+    bool progress = true;
+    while (progress && attempts < MAX_ATTEMPTS) {
+        progress = false;
+
+        // Drop chunks of processes, halving the chunk size down to single processes
+        for (size_t chunk = std::max<size_t>(best.processes.size() / 2, 1); chunk >= 1; chunk /= 2) {
+            for (size_t start = 0; start < best.processes.size() && best.processes.size() > 1;) {
+                Scenario candidate = best;
+                size_t end = std::min(start + chunk, candidate.processes.size());
+                candidate.processes.erase(candidate.processes.begin() + start, candidate.processes.begin() + end);
+                if (!candidate.processes.empty() && tryCandidate(candidate)) {
+                    progress = true;
+                } else {
+                    start += chunk;
+                }
+            }
+            if (chunk == 1) break;
+        }
+
+        // Simplify each process towards arrival 0, burst 1, priority 0
+        for (size_t i = 0; i < best.processes.size(); ++i) {
+            for (double v : simpler(best.processes[i].arrivalTime, 0)) {
+                Scenario candidate = best;
+                candidate.processes[i].arrivalTime = v;
+                if (tryCandidate(candidate)) { progress = true; break; }
+            }
+            for (double v : simpler(best.processes[i].burstTime, 1)) {
+                Scenario candidate = best;
+                candidate.processes[i].burstTime = v;
+                if (tryCandidate(candidate)) { progress = true; break; }
+            }
+            for (double v : simpler(best.processes[i].priority, 0)) {
+                Scenario candidate = best;
+                candidate.processes[i].priority = static_cast<int>(v);
+                if (tryCandidate(candidate)) { progress = true; break; }
+            }
+        }
+
+        // Simplify the configuration
+        if (best.config.agingEnabled) {
+            Scenario candidate = best;
+            candidate.config.agingEnabled = false;
+            if (tryCandidate(candidate)) progress = true;
+        }
+        if (best.contextSwitchCost > 0) {
+            Scenario candidate = best;
+            candidate.contextSwitchCost = 0;
+            if (tryCandidate(candidate)) progress = true;
+        }
+        for (double v : simpler(best.config.timeQuantum, 1)) {
+            Scenario candidate = best;
+            candidate.config.timeQuantum = v;
+            if (tryCandidate(candidate)) { progress = true; break; }
+        }
+    }
+
+    // Dense ids in input order read best, but ids take part in tie-breaks
+    Scenario renumbered = best;
+    for (size_t i = 0; i < renumbered.processes.size(); ++i) {
+        renumbered.processes[i].id = static_cast<int>(i) + 1;
+        renumbered.processes[i].name = "P" + std::to_string(i + 1);
+    }
+    tryCandidate(renumbered);
+    return best;
+}
+
+DiffReport runDifferential(const Engine& engine, int cases, uint64_t seed,
+                           const std::vector<std::string>& algorithms) {
+    auto mismatch = [&](const Scenario& s) {
+        return compareTraces(runReference(s), engine.run(s));
+    };
+
+    DiffReport report;
+    for (int i = 0; i < cases; ++i) {
+        Scenario s = randomScenario(seed + i, algorithms);
+        report.casesRun++;
+        if (mismatch(s).empty()) continue;
+
+        report.ok = false;
+        report.failingSeed = seed + i;
+        report.reproducer = shrinkScenario(s, [&](const Scenario& c) { return !mismatch(c).empty(); });
+        report.mismatch = mismatch(report.reproducer);
+        break;
+    }
+    return report;
+}
@@ -0,0 +1,92 @@
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "scenario.h"
+
+/**
+ * Differential equivalence harness
+ * Runs randomized scenarios through the reference engine (Scheduler::tick()
+ * one step at a time) and an alternative engine, compares what they produced
+ * and shrinks any mismatch to a minimal reproducer scenario
+ */
+
+/**
+ * Final metrics of one finished process (base units)
+ */
+struct Outcome {
+    int id;
+    SimTime completion;
+    SimTime waiting;
+    SimTime turnaround;
+    SimTime response;
+    int priority;   // After aging / boosts, catches clamp differences
+};
+
+/**
+ * Everything an engine run is compared on
+ */
+struct Trace {
+    std::vector<int32_t> timeline;   // lastExecutedId of every tick (the event sequence)
+    std::vector<Outcome> finished;   // In finish order
+    SimTime endTime = 0;
+    uint64_t stateHash = 0;          // Scheduler::getStateHash() at the end
+    bool truncated = false;          // Hit the tick cap before finishing
+};
+
+/**
+ * An engine turns a scenario into a trace
+ */
+struct Engine {
+    std::string name;
+    std::function<Trace(const Scenario&)> run;
+};
+
+const int DIFF_MAX_TICKS = 20000;  // Per run; random scenarios finish far sooner
+
+/**
+ * Read the trace of a scheduler that has run (timeline recording must be on)
+ */
+Trace collectTrace(const Scheduler& scheduler, bool truncated);
+
+/**
+ * Reference: applyScenario() then tick() until finished
+ */
+Trace runReference(const Scenario& scenario);
+
+/**
+ * "" when equal, otherwise a description of the first difference
+ */
+std::string compareTraces(const Trace& expected, const Trace& actual);
+
+/**
+ * Small random scenario biased towards ties (equal arrivals, bursts and
+ * priorities) so tie-breaks are exercised; 'algorithms' picks the policy
+ */
+Scenario randomScenario(uint64_t seed, const std::vector<std::string>& algorithms);
+
+/**
+ * Greedily drop processes and simplify values and config while 'fails' holds
+ */
+Scenario shrinkScenario(const Scenario& failing, const std::function<bool(const Scenario&)>& fails);
+
+struct DiffReport {
+    bool ok = true;
+    int casesRun = 0;
+    uint64_t failingSeed = 0;
+    std::string mismatch;      // On the shrunk reproducer
+    Scenario reproducer;
+};
+
+/**
+ * Compare 'engine' to the reference on 'cases' scenarios (seeds seed, seed + 1, ...)
+ * Stops at the first mismatch and shrinks it
+ */
+DiffReport runDifferential(const Engine& engine, int cases, uint64_t seed,
+                           const std::vector<std::string>& algorithms);
+
+#endif
@@ -0,0 +1,1503 @@
+#include "differential.h"
+#include "policy_plugin.h"
+#include "scheduler_c.h"
+#include "state_hash.h"
+#include "sweep.h"
+#include "tuner.h"
+#include "workloads.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+/**
+ * Minimal self-contained test runner (registered with CTest)
+ *   scheduler_test [cases] [seed]
+ * 'cases' is the number of random scenarios per differential check (default 300)
+ */
+
+namespace {
+
+int failures = 0;
+int casesPerEngine = 300;
+uint64_t baseSeed = 1;
+
+const std::vector<std::string> ALGORITHMS = {"FCFS", "SJF", "SRTF", "RR", "Priority", "PriorityNP", "HRRN", "HRRNP"};
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cerr << "  " << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed" << std::endl; \
+            failures++; \
+        } \
+    } while (0)
+
+/**
+ * Report a differential failure with the shrunk reproducer as a scenario file
+ */
+void checkEquivalent(const Engine& engine, const std::vector<std::string>& algorithms = ALGORITHMS) {
+    DiffReport report = runDifferential(engine, casesPerEngine, baseSeed, algorithms);
+    if (report.ok) return;
+    failures++;
+    std::cerr << "  " << engine.name << " differs from tick() (seed " << report.failingSeed << "): "
+              << report.mismatch << "\n  Minimal reproducer:\n" << formatScenario(report.reproducer);
+}
+
+Trace runScheduler(Scheduler& scheduler, const std::function<bool(Scheduler&)>& step) {
+    scheduler.setRecordTimeline(true);
+    int ticks = 0;
+    while (!scheduler.isFinished() && ticks < DIFF_MAX_TICKS) {
+        if (!step(scheduler)) break;
+        ticks = static_cast<int>(scheduler.getTimelineStart() + scheduler.getTimeline().size());
+    }
+    return collectTrace(scheduler, !scheduler.isFinished());
+}
+
+// === Differential checks ===
+
+std::vector<int32_t> runTimeline(Scheduler& scheduler) {
+    scheduler.setRecordTimeline(true);
+    while (!scheduler.isFinished()) scheduler.tick();
+    return scheduler.getTimeline();
+}
+
+void testRunForMatchesTick() {
+    for (int chunk : {1, 3, 64}) {
+        checkEquivalent({"runFor(maxTicks=" + std::to_string(chunk) + ")", [chunk](const Scenario& s) {
+            Scheduler scheduler;
+            applyScenario(s, scheduler);
+            return runScheduler(scheduler, [chunk](Scheduler& sch) {
+                return sch.runFor(1e9, chunk).ticks > 0;
+            });
+        }});
+    }
+}
+
+void testScenarioRoundTripMatchesTick() {
+    checkEquivalent({"text scenario round trip", [](const Scenario& s) {
+        Scenario loaded;
+        std::vector<ScenarioError> errors;
+        parseScenario(formatScenario(s), loaded, errors);
+        Scheduler scheduler;
+        applyScenario(loaded, scheduler);
+        return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+    }});
+    checkEquivalent({"binary scenario round trip", [](const Scenario& s) {
+        Scenario loaded;
+        std::vector<ScenarioError> errors;
+        parseScenarioBinary(formatScenarioBinary(s), loaded, errors);
+        Scheduler scheduler;
+        applyScenario(loaded, scheduler);
+        return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+    }});
+}
+
+void testParallelSweepMatchesSingleJobs() {
+    for (int i = 0; i < casesPerEngine / 10; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        std::vector<SweepJob> jobs;
+        for (const auto& algo : ALGORITHMS) {
+            SweepJob job = s.config;
+            job.algorithm = algo;
+            jobs.push_back(job);
+        }
+        std::vector<SweepResult> parallel = runSweep(s.processes, jobs, 3);
+        CHECK(parallel.size() == jobs.size());
+        for (size_t j = 0; j < jobs.size() && j < parallel.size(); ++j) {
+            SweepResult single = runSweepJob(s.processes, jobs[j]);
+            CHECK(parallel[j].job.algorithm == jobs[j].algorithm);
+            CHECK(parallel[j].avgWaitingTime == single.avgWaitingTime);
+            CHECK(parallel[j].avgTurnaroundTime == single.avgTurnaroundTime);
+            CHECK(parallel[j].maxResponseTime == single.maxResponseTime);
+            CHECK(parallel[j].ticks == single.ticks);
+        }
+    }
+}
+
+void testProcessTableMatchesProcesses() {
+    for (int i = 0; i < casesPerEngine / 10; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        Scheduler scheduler;
+        applyScenario(s, scheduler);
+        while (!scheduler.isFinished()) {
+            scheduler.tick();
+            const ProcessTable& table = scheduler.syncProcessTable();
+            CHECK(table.ids.size() == s.processes.size());
+            for (size_t row = 0; row < table.ids.size(); ++row) {
+                const Process* p = scheduler.getProcess(table.ids[row]);
+                CHECK(p != nullptr && p->id == table.ids[row]);
+                if (p && table.state[row] == ProcessTable::FINISHED) {
+                    CHECK(table.waiting[row] == static_cast<double>(p->waitingTime));
+                    CHECK(table.turnaround[row] == static_cast<double>(p->turnaroundTime));
+                }
+            }
+            
+            // The incremental sync must agree with a full rewrite
+            Scheduler full = scheduler;
+            full.setTimeResolution(s.timeResolution);
+            const ProcessTable& rebuilt = full.syncProcessTable();
+            CHECK(table.state == rebuilt.state);
+            CHECK(table.remaining == rebuilt.remaining);
+            CHECK(table.priority == rebuilt.priority);
+            CHECK(table.readyOrder == rebuilt.readyOrder);
+            CHECK(table.waiting == rebuilt.waiting);
+        }
+    }
+}
+
+void testTimelineCapacityKeepsNewest() {
+    Scheduler scheduler;
+    scheduler.setAlgorithm("RR");
+    for (int id = 1; id <= 3; ++id) scheduler.addProcess(id, "P", 0, 7, 0);
+    std::vector<int32_t> full = runTimeline(scheduler);
+    
+    Scheduler capped;
+    capped.setAlgorithm("RR");
+    for (int id = 1; id <= 3; ++id) capped.addProcess(id, "P", 0, 7, 0);
+    capped.setTimelineCapacity(8);
+    std::vector<int32_t> kept = runTimeline(capped);
+    CHECK(kept.size() <= 8);
+    CHECK(capped.getTimelineStart() + kept.size() == full.size());
+    CHECK(std::equal(kept.begin(), kept.end(), full.end() - kept.size()));
+}
+
+// === Multilevel queue ===
+
+void testMultilevelDefaultClassMatchesFCFS() {
+    checkEquivalent({"MLQ default class", [](const Scenario& s) {
+        Scheduler scheduler;
+        applyScenario(s, scheduler);
+        scheduler.setAlgorithm("MLQ");
+        return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+    }}, {"FCFS"});
+}
+
+void testMultilevelStrictAndTimeSlice() {
+    // Foreground RR (quantum 1) over background FCFS; the explicit classes
+    // replace the default one, or 2 and 3 would not alternate
+    Scheduler strict;
+    strict.setAlgorithm("MLQ");
+    CHECK(strict.addQueueClass("RR", 1, 1) == 0);
+    CHECK(strict.addQueueClass("FCFS", 2, 1) == 1);
+    strict.addProcess(1, "batch", 0, 3, 1);
+    strict.addProcess(2, "shell", 1, 2, 1);
+    strict.addProcess(3, "editor", 1, 2, 1);
+    strict.setProcessClass(1, 1);
+    CHECK((runTimeline(strict) == std::vector<int32_t>{1, 2, 3, 2, 3, 1, 1}));
+    CHECK(strict.getProcess(1)->waitingTime == 4);
+
+    // Classes take turns of 2 and 1 ticks, skipping empty ones
+    Scheduler sliced;
+    sliced.setAlgorithm("MLQ");
+    sliced.setInterQueuePolicy("TimeSlice");
+    sliced.addQueueClass("FCFS", 2, 2);
+    sliced.addQueueClass("FCFS", 2, 1);
+    sliced.addProcess(1, "fg", 0, 4, 1);
+    sliced.addProcess(2, "bg", 0, 2, 1);
+    sliced.setProcessClass(2, 1);
+    CHECK((runTimeline(sliced) == std::vector<int32_t>{1, 1, 2, 1, 1, 2}));
+
+    // Out-of-range classes are clamped to the last one
+    Scheduler clamped;
+    clamped.setAlgorithm("MLQ");
+    clamped.addQueueClass("FCFS", 2, 1);
+    clamped.addQueueClass("SJF", 2, 1);
+    clamped.addProcess(1, "long", 0, 3, 1);
+    clamped.addProcess(2, "longer", 1, 4, 1);
+    clamped.addProcess(3, "short", 1, 1, 1);
+    clamped.setProcessClass(1, 9);
+    clamped.setProcessClass(2, 9);
+    clamped.setProcessClass(3, 9);
+    CHECK((runTimeline(clamped) == std::vector<int32_t>{1, 1, 1, 3, 2, 2, 2, 2}));
+}
+
+// === Resource locks ===
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t n = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) n++;
+    return n;
+}
+
+void testLockRetakenInOneBurst() {
+    // Same lock twice in one burst: released after 2 executed, taken again at 3
+    // until 5; the overlapping third request is ignored
+    Scheduler alone;
+    alone.addProcess(1, "worker", 0, 6, 1);
+    alone.addLockRequest(1, 7, 0, 2);
+    alone.addLockRequest(1, 7, 3, 5);
+    alone.addLockRequest(1, 7, 1, 4);
+    std::string log;
+    while (!alone.isFinished()) log += alone.tick() + "\n";
+    CHECK(countOf(log, "Process 1 acquired L7") == 2);
+    CHECK(countOf(log, "Process 1 released L7") == 2);
+    CHECK(log.find("Time 2: Running Process 1 (4 remaining). Process 1 released L7.") == std::string::npos);
+    CHECK(log.find("Time 4: Running Process 1 (2 remaining). Process 1 released L7.") != std::string::npos);
+
+    // The second acquisition is held until its own release offset: 3 blocks on it
+    Scheduler contended;
+    contended.setAlgorithm("Priority");
+    contended.addProcess(1, "worker", 0, 6, 2);
+    contended.addProcess(3, "urgent", 4, 1, 0);
+    contended.addLockRequest(1, 7, 0, 2);
+    contended.addLockRequest(1, 7, 3, 5);
+    contended.addLockRequest(3, 7, 0, 1);
+    CHECK((runTimeline(contended) == std::vector<int32_t>{1, 1, 1, 1, 1, 3, 1}));
+    CHECK(contended.getProcess(3)->blockedTime == 1);
+}
+
+void testProtocolsBoundPriorityInversion() {
+    // Classic inversion: low holds L1 when high arrives and blocks on it, then
+    // medium (no lock) arrives and would run ahead of low while high waits
+    struct Expected {
+        const char* protocol;
+        SimTime inversion, unbounded, highDone;
+        bool highBlocks;
+    };
+    const Expected cases[] = {
+        {"None", 7, 5, 10, true},        // Medium's whole burst counts as unbounded
+        {"Inheritance", 2, 0, 5, true},  // Low runs at high's priority until it releases
+        {"Ceiling", 0, 0, 5, false},     // Low holds L1 at its ceiling, so high never preempts it
+    };
+    for (const Expected& e : cases) {
+        Scheduler scheduler;
+        scheduler.setAlgorithm("Priority");
+        scheduler.setLockProtocol(e.protocol);
+        scheduler.addProcess(1, "low", 0, 4, 3);
+        scheduler.addProcess(2, "medium", 2, 5, 2);
+        scheduler.addProcess(3, "high", 1, 2, 1);
+        scheduler.addLockRequest(1, 1, 0, 3);
+        scheduler.addLockRequest(3, 1, 0, 1);
+        
+        scheduler.tick();
+        CHECK(scheduler.getProcess(1)->priority == (e.protocol == std::string("Ceiling") ? 1 : 3));
+        scheduler.tick();
+        CHECK((scheduler.getProcessJSON(3)["state"] == "blocked") == e.highBlocks);
+        bool boosted = e.protocol != std::string("None");
+        CHECK(scheduler.getProcess(1)->priority == (boosted ? 1 : 3));
+        CHECK(scheduler.getProcess(1)->basePriority == (boosted ? 3 : -1));
+        while (!scheduler.isFinished()) scheduler.tick();
+        
+        nlohmann::json locks = scheduler.getStateJSON()["locks"];
+        CHECK(locks["inversion_time"] == e.inversion);
+        CHECK(locks["unbounded_inversion_time"] == e.unbounded);
+        CHECK(locks["blocked"].empty());
+        CHECK(scheduler.getProcess(3)->inversionTime == e.inversion);
+        CHECK(scheduler.getProcess(3)->completionTime == e.highDone);
+        CHECK(scheduler.getProcess(1)->priority == 3);  // Boosts dropped with the lock
+    }
+}
+
+void testLookupFollowsEveryMove() {
+    // Every container a process can move through: MLQ classes, lock waiters, gangs,
+    // and ready queues reordered by sorts and heaps (lookups never scan for a position)
+    std::vector<Scheduler> single(6);
+    const char* reordering[] = {"SJF", "SRTF", "Priority", "HRRNP", "Expr", "ExprP"};
+    for (size_t i = 0; i < single.size(); ++i) {
+        single[i].setAlgorithm(reordering[i]);
+        CHECK(single[i].setPriorityExpression(i == 4 ? "burst - priority" : "remaining").empty());
+        for (int id = 1; id <= 12; ++id) {
+            single[i].addProcess(id, "s", id % 4, 1 + (id * 5) % 7, id % 3);
+            single[i].addLockRequest(id, 1, 0, 3);  // Preempted holders leave several waiters
+        }
+    }
+    Scheduler mlq;
+    mlq.setAlgorithm("MLQ");
+    mlq.addQueueClass("Priority", 2, 1);
+    mlq.addQueueClass("RR", 2, 1);
+    mlq.setLockProtocol("Inheritance");
+    for (int id = 1; id <= 6; ++id) {
+        mlq.addProcess(id, "p", id / 2, 3 + id % 3, id % 3);
+        mlq.setProcessClass(id, id % 2);
+        mlq.addLockRequest(id, 1 + id % 2, 0, 2);
+    }
+    Scheduler gang;
+    gang.setAlgorithm("Gang");
+    gang.setCoreCount(4);
+    for (int id = 1; id <= 5; ++id) {
+        gang.addProcess(id, "g", id - 1, 2 + id % 3, 0);
+        gang.setProcessThreads(id, 1 + id % 4);
+    }
+    
+    static const char* stateNames[] = {"not_arrived", "ready", "running", "finished", "blocked"};
+    std::vector<Scheduler*> all = {&mlq, &gang};
+    for (auto& scheduler : single) all.push_back(&scheduler);
+    for (Scheduler* scheduler : all) {
+        bool blocked = false;
+        while (!scheduler->isFinished()) {
+            scheduler->tick();
+            const ProcessTable& table = scheduler->syncProcessTable();
+            for (size_t row = 0; row < table.ids.size(); ++row) {
+                const Process* p = scheduler->getProcess(table.ids[row]);
+                CHECK(p != nullptr && p->id == table.ids[row]);
+                CHECK(scheduler->getProcessJSON(table.ids[row])["state"] == stateNames[table.state[row]]);
+                blocked = blocked || table.state[row] == ProcessTable::BLOCKED;
+            }
+        }
+        CHECK(scheduler != &mlq || blocked);
+    }
+}
+
+// === Gang scheduling ===
+
+void testGangWaitsForCoresAndRotates() {
+    // 4 cores, 2-tick slots: A (3 threads) + C (1) fill slot 1 while B (2) waits;
+    // slot 2 rotates B ahead of A, and A (needing 3 of the 2 free cores) waits
+    Scheduler scheduler;
+    scheduler.setAlgorithm("Gang");
+    scheduler.setCoreCount(4);
+    scheduler.setTimeQuantum(2);
+    scheduler.addProcess(1, "A", 0, 4, 0);
+    scheduler.addProcess(2, "B", 0, 2, 0);
+    scheduler.addProcess(3, "C", 0, 3, 0);
+    scheduler.setProcessThreads(1, 3);
+    scheduler.setProcessThreads(2, 2);
+    scheduler.setProcessThreads(3, 1);
+    
+    auto gang = [&] { return scheduler.getStateJSON()["gang"]; };
+    scheduler.tick();
+    CHECK(gang()["core_owner"] == nlohmann::json::array({1, 1, 1, 3}));
+    CHECK(scheduler.getProcessJSON(2)["state"] == "ready");
+    scheduler.tick();
+    CHECK(gang()["fragmented_core_time"] == 0);  // No core was idle
+    
+    scheduler.tick();  // Slot 2: B first, C refills a core, A does not fit
+    CHECK(gang()["running"].size() == 1 && gang()["running"][0]["cores"] == nlohmann::json::array({0, 1}));
+    CHECK(scheduler.getProcess(3)->completionTime == 3);
+    scheduler.tick();
+    CHECK(scheduler.getProcessJSON(1)["state"] == "ready");
+    CHECK(gang()["fragmented_core_time"] == 3);  // Core 3 for a tick, then cores 2-3
+    
+    scheduler.tick();  // A takes a fresh 2-tick slot once B is done
+    CHECK(gang()["core_owner"] == nlohmann::json::array({1, 1, 1, -1}));
+    CHECK(scheduler.tick().find("Slot ended") == std::string::npos);
+    CHECK(scheduler.isFinished());
+    CHECK(scheduler.getProcess(1)->completionTime == 6);
+    CHECK(scheduler.getProcess(2)->completionTime == 4);
+    
+    nlohmann::json done = gang();
+    CHECK(done["busy_core_time"] == 19);
+    CHECK(done["idle_core_time"] == 5);
+    CHECK(done["fragmented_core_time"] == 3);  // Idle with A waiting, not after it ran
+}
+
+void testGangCoresSpanMaskWords() {
+    // 70 cores: the 8-thread gang takes cores 60-67 across the first 64-bit mask
+    // word; the 5-thread gang waits with 2 cores free, then reuses the low cores
+    Scheduler scheduler;
+    scheduler.setAlgorithm("Gang");
+    scheduler.setCoreCount(70);
+    scheduler.setTimeQuantum(4);
+    scheduler.addProcess(1, "wide", 0, 2, 0);
+    scheduler.addProcess(2, "straddle", 0, 2, 0);
+    scheduler.addProcess(3, "late", 0, 2, 0);
+    scheduler.setProcessThreads(1, 60);
+    scheduler.setProcessThreads(2, 8);
+    scheduler.setProcessThreads(3, 5);
+    
+    scheduler.tick();
+    nlohmann::json gang = scheduler.getStateJSON()["gang"];
+    CHECK(gang["running"].size() == 2);
+    CHECK(gang["running"][0]["cores"].size() == 60);
+    CHECK(gang["running"][1]["cores"] == nlohmann::json::array({60, 61, 62, 63, 64, 65, 66, 67}));
+    for (int core = 0; core < 70; ++core) {
+        CHECK(gang["core_owner"][core] == (core < 60 ? 1 : core < 68 ? 2 : -1));
+    }
+    
+    scheduler.tick();
+    scheduler.tick();
+    gang = scheduler.getStateJSON()["gang"];
+    CHECK(gang["running"].size() == 1 && gang["running"][0]["cores"] == nlohmann::json::array({0, 1, 2, 3, 4}));
+    while (!scheduler.isFinished()) scheduler.tick();
+    CHECK(scheduler.getProcess(3)->completionTime == 4);
+    CHECK(scheduler.getStateJSON()["gang"]["fragmented_core_time"] == 4);
+}
+
+// === Paged history ===
+
+void testLogRingKeepsNewestAcrossWraps() {
+    Scheduler scheduler;
+    scheduler.setAlgorithm("RR");
+    scheduler.addProcess(1, "A", 0, 30, 0);
+    scheduler.addProcess(2, "B", 0, 30, 0);
+    scheduler.setLogCapacity(7);
+    std::vector<std::string> logs;
+    while (!scheduler.isFinished()) logs.push_back(scheduler.tick());
+    
+    std::vector<LogEntry> page = scheduler.getLog(0, 100);
+    CHECK(page.size() == 7);
+    for (size_t i = 0; i < page.size(); ++i) {
+        size_t tick = logs.size() - page.size() + i;
+        CHECK(page[i].time == static_cast<SimTime>(tick));
+        CHECK(page[i].text == logs[tick]);
+    }
+    
+    // Paging from a time inside the ring, then shrinking it
+    std::vector<LogEntry> tail = scheduler.getLog(static_cast<double>(logs.size() - 2), 100);
+    CHECK(tail.size() == 2 && tail[0].text == logs[logs.size() - 2]);
+    scheduler.setLogCapacity(3);
+    page = scheduler.getLog(0, 2);
+    CHECK(page.size() == 2);
+    CHECK(page[0].text == logs[logs.size() - 3] && page[1].text == logs[logs.size() - 2]);
+}
+
+void testDecisionRulesOutliveAlgorithm() {
+    Scheduler scheduler;
+    scheduler.setAlgorithm("SRTF");
+    scheduler.addProcess(1, "A", 0, 8, 0);
+    scheduler.addProcess(2, "B", 1, 2, 0);
+    scheduler.setExplainCapacity(16);
+    while (!scheduler.isFinished()) scheduler.tick();
+    scheduler.setAlgorithm("FCFS");
+    
+    // Rules are static names, unaffected by later configuration
+    std::vector<DecisionRecord> decisions = scheduler.getDecisions(0, 16);
+    CHECK(!decisions.empty());
+    bool preempted = false;
+    for (const auto& d : decisions) {
+        CHECK(std::string(d.rule) == "SRTF");
+        if (d.kind == DecisionRecord::PREEMPT) {
+            preempted = true;
+            CHECK(d.time == 1 && d.chosenId == 2 && d.preemptedId == 1);
+        }
+    }
+    CHECK(preempted);
+    
+    // A name outside the built-ins is interned once and outlives its string
+    Scheduler custom;
+    std::string name = "Custom";
+    custom.setAlgorithm(name);
+    custom.addProcess(1, "A", 0, 1, 0);
+    custom.addProcess(2, "B", 2, 1, 0);
+    custom.setExplainCapacity(4);
+    while (!custom.isFinished()) custom.tick();
+    custom.setAlgorithm("FCFS");
+    decisions = custom.getDecisions(0, 4);
+    CHECK(decisions.size() == 2 && decisions[0].rule == decisions[1].rule);
+    CHECK(std::string(decisions[0].rule) == "Custom" && decisions[0].rule != name.c_str());
+}
+
+void testFinishedPagesSortAndClamp() {
+    struct SortKey {
+        const char* name;
+        SimTime (*value)(const Process&);
+    };
+    const SortKey keys[] = {
+        {"id", [](const Process& p) -> SimTime { return p.id; }},
+        {"priority", [](const Process& p) -> SimTime { return p.originalPriority; }},
+        {"arrival", [](const Process& p) { return p.arrivalTime; }},
+        {"burst", [](const Process& p) { return p.burstTime; }},
+        {"completion", [](const Process& p) { return p.completionTime; }},
+        {"waiting", [](const Process& p) { return p.waitingTime; }},
+        {"turnaround", [](const Process& p) { return p.turnaroundTime; }},
+        {"response", [](const Process& p) { return p.responseTime; }},
+    };
+    Scheduler scheduler;
+    scheduler.setAlgorithm("RR");
+    scheduler.setTimeQuantum(2);
+    for (int id = 1; id <= 9; ++id) {
+        scheduler.addProcess(id * 3 % 10, "p", id % 4, 1 + id * 7 % 5, id % 3);
+    }
+    
+    // Checked after every tick, so cached orders are extended by later finishers
+    while (!scheduler.isFinished()) {
+        scheduler.tick();
+        const std::vector<Process>& finished = scheduler.getFinishedProcesses();
+        std::map<int, size_t> finishRank;
+        for (size_t i = 0; i < finished.size(); ++i) finishRank[finished[i].id] = i;
+        
+        for (const SortKey& key : keys) {
+            for (bool descending : {false, true}) {
+                std::vector<Process> page = scheduler.getFinished(0, 100, (descending ? "-" : "") + std::string(key.name));
+                CHECK(page.size() == finished.size());
+                for (size_t i = 1; i < page.size(); ++i) {
+                    SimTime a = key.value(page[i - 1]), b = key.value(page[i]);
+                    CHECK(descending ? a >= b : a <= b);
+                    if (a == b) CHECK(finishRank[page[i - 1].id] < finishRank[page[i].id]);
+                }
+            }
+        }
+        
+        // Unknown keys, with or without '-', are finish order
+        for (const char* unknown : {"", "bogus", "-bogus", "-"}) {
+            std::vector<Process> page = scheduler.getFinished(0, 100, unknown);
+            CHECK(page.size() == finished.size());
+            for (size_t i = 0; i < page.size(); ++i) CHECK(page[i].id == finished[i].id);
+        }
+    }
+    
+    // Offset / count edges
+    std::vector<Process> all = scheduler.getFinished(0, 100, "id");
+    CHECK(all.size() == 9);
+    CHECK(scheduler.getFinished(0, 0, "id").empty());
+    CHECK(scheduler.getFinished(9, 5, "id").empty());
+    CHECK(scheduler.getFinished(1000, 5, "id").empty());
+    std::vector<Process> last = scheduler.getFinished(8, 5, "id");
+    CHECK(last.size() == 1 && last[0].id == all[8].id);
+    std::vector<Process> middle = scheduler.getFinished(3, 4, "-id");
+    CHECK(middle.size() == 4);
+    for (size_t i = 0; i < middle.size(); ++i) CHECK(middle[i].id == all[5 - i].id);
+}
+
+// === Energy / DVFS ===
+
+void testDvfsWaitingExcludesSlowdown() {
+    // Alone on the core, a process never waits, whatever speed it runs at
+    for (const char* governor : {"performance", "powersave"}) {
+        Scheduler scheduler;
+        scheduler.setDVFS(true);
+        scheduler.addFrequencyState(1000, 0.9);
+        scheduler.addFrequencyState(2000, 1.1);
+        scheduler.setReferenceFrequency(1500);
+        scheduler.setGovernor(governor);
+        scheduler.addProcess(1, "solo", 0, 6, 1);
+        scheduler.addProcess(2, "later", 1, 3, 1);
+        while (!scheduler.isFinished()) scheduler.tick();
+
+        const Process* solo = scheduler.getProcess(1);
+        const Process* later = scheduler.getProcess(2);
+        bool fast = std::string(governor) == "performance";
+        CHECK(solo->turnaroundTime == (fast ? 5 : 9));     // ceil(6 * 1500 / MHz)
+        CHECK(solo->waitingTime == 0);
+        CHECK(later->waitingTime == solo->completionTime - 1);
+        CHECK(later->waitingTime + later->cpuTime == later->turnaroundTime);
+    }
+}
+
+void testEnergyAndThroughputAcrossResolutions() {
+    // Default states (800/1600/2400 MHz at 0.8/1.0/1.2 V), 0.5 W static, C = 0.0005;
+    // a busy stretch, an idle gap, then another busy stretch
+    struct Expected {
+        const char* governor;
+        SimTime resolution;
+        double makespan, staticEnergy, dynamicEnergy, busyMHz;
+        int coreMHz;
+    };
+    const Expected cases[] = {
+        // 5 busy + 2 idle units at 2400 MHz: 1.728 W dynamic per busy unit
+        {"performance", 1, 7, 3.5, 8.64, 2400, 2400},
+        {"performance", 4, 7, 3.5, 8.64, 2400, 2400},
+        // 3x slower at 800 MHz, so b arrives while a still runs: 15 busy units at 0.256 W
+        {"powersave", 1, 15, 7.5, 3.84, 800, 800},
+        {"powersave", 4, 15, 7.5, 3.84, 800, 800},
+        // Each stretch starts one state down (1600 MHz, 0.8 W dynamic) after an idle tick:
+        // 1600, 2400 x3, idle, 1600, 2400 x2
+        {"ondemand", 1, 8, 4.0, 10.24, 15200.0 / 7, 2400},
+    };
+    for (const Expected& e : cases) {
+        Scheduler scheduler;
+        scheduler.setTimeResolution(e.resolution);
+        scheduler.setDVFS(true);
+        scheduler.setGovernor(e.governor);
+        scheduler.setPowerModel(0.5, 0.0005);
+        scheduler.addProcess(1, "a", 0, 3, 0);
+        scheduler.addProcess(2, "b", 5, 2, 0);
+        while (!scheduler.isFinished()) scheduler.tick();
+        
+        nlohmann::json energy = scheduler.getStateJSON()["energy"];
+        auto near = [](double a, double b) { return std::fabs(a - b) < 1e-9; };
+        CHECK(scheduler.getCurrentTime() == static_cast<SimTime>(e.makespan) * e.resolution);
+        CHECK(near(energy["static_energy"], e.staticEnergy));
+        CHECK(near(energy["dynamic_energy"], e.dynamicEnergy));
+        CHECK(near(energy["energy"], e.staticEnergy + e.dynamicEnergy));
+        CHECK(near(energy["energy_per_process"], (e.staticEnergy + e.dynamicEnergy) / 2));
+        CHECK(near(energy["throughput"], 2 / e.makespan));
+        CHECK(near(energy["avg_busy_mhz"], e.busyMHz));
+        CHECK(energy["core_mhz"] == nlohmann::json::array({e.coreMHz}));
+    }
+}
+
+// === Time base ===
+
+void testResolutionRescalesSettings() {
+    // Settings made before setTimeResolution() keep their meaning in time units
+    auto run = [](bool resolutionFirst) {
+        Scheduler scheduler;
+        if (resolutionFirst) scheduler.setTimeResolution(4);
+        scheduler.setAlgorithm("RR");
+        scheduler.setTimeQuantum(3);
+        scheduler.setContextSwitchCost(1);
+        scheduler.setAging(true);
+        scheduler.setAgingThreshold(2);
+        if (!resolutionFirst) scheduler.setTimeResolution(4);
+        scheduler.addProcess(1, "a", 0, 5, 3);
+        scheduler.addProcess(2, "b", 1, 4, 2);
+        scheduler.addProcess(3, "c", 2, 2, 1);
+        while (!scheduler.isFinished()) scheduler.tick();
+        return scheduler.getStateJSON()["finished"];
+    };
+    nlohmann::json expected = run(true);
+    CHECK(run(false) == expected);
+    CHECK(expected[0]["turnaround_time"].is_number_float());
+
+    // The default quantum (2) is 2 time units at any resolution
+    Scheduler scaled;
+    scaled.setAlgorithm("RR");
+    scaled.setTimeResolution(10);
+    scaled.addProcess(1, "a", 0, 3, 1);
+    scaled.addProcess(2, "b", 0, 3, 1);
+    while (!scaled.isFinished()) scaled.tick();
+    CHECK(scaled.getProcess(1)->completionTime == 50);
+    CHECK(scaled.getProcess(2)->completionTime == 60);
+}
+
+// === Configuration tuner ===
+
+bool sameCandidates(const TuneResult& a, const TuneResult& b) {
+    if (a.candidates.size() != b.candidates.size() || a.best != b.best || a.pareto != b.pareto) return false;
+    for (size_t i = 0; i < a.candidates.size(); ++i) {
+        const TuneCandidate& x = a.candidates[i];
+        const TuneCandidate& y = b.candidates[i];
+        if (x.rung != y.rung || x.feasible != y.feasible || x.config.timeQuantum != y.config.timeQuantum ||
+            x.metrics.avgWaitingTime != y.metrics.avgWaitingTime ||
+            x.metrics.p99ResponseTime != y.metrics.p99ResponseTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testTunerDeterministicAndSound() {
+    TuneObjective objective;
+    std::string error;
+    CHECK(parseTuneObjective("minimize p99_response_time subject to makespan <= 1e9", objective, error));
+    TuneSpace space;
+    space.algorithms = ALGORITHMS;
+    TuneOptions options;
+    options.candidates = 24;
+
+    for (int i = 0; i < casesPerEngine / 30; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        options.seed = baseSeed + i;
+        options.threads = 1;
+        TuneResult serial = tuneScenario(s, objective, space, options);
+        options.threads = 4;
+        TuneResult parallel = tuneScenario(s, objective, space, options);
+        CHECK(sameCandidates(serial, parallel));
+
+        // The scenario's own config always runs to completion, so the best is never worse
+        const TuneCandidate& baseline = serial.candidates[0];
+        CHECK(baseline.metrics.complete && baseline.feasible);
+        CHECK(serial.best >= 0);
+        if (serial.best < 0) continue;
+        const TuneCandidate& best = serial.candidates[serial.best];
+        CHECK(best.metrics.p99ResponseTime <= baseline.metrics.p99ResponseTime);
+
+        // Resuming across rungs ends where a single uninterrupted run does
+        if (s.timeResolution == 1 && s.contextSwitchCost == 0) {
+            SweepResult single = runSweepJob(s.processes, best.config);
+            CHECK(best.metrics.avgWaitingTime == single.avgWaitingTime);
+            CHECK(best.metrics.maxResponseTime == single.maxResponseTime);
+        }
+
+        for (int a : serial.pareto) {
+            CHECK(serial.candidates[a].metrics.complete);
+            for (int b : serial.pareto) {
+                const TuneMetrics& x = serial.candidates[a].metrics;
+                const TuneMetrics& y = serial.candidates[b].metrics;
+                CHECK(a == b || x.p99ResponseTime < y.p99ResponseTime || x.makespan < y.makespan);
+            }
+        }
+    }
+}
+
+void testTunerFrontCoversCompleteCandidates() {
+    TuneObjective objective;
+    std::string error;
+    CHECK(parseTuneObjective("minimize avg_waiting_time subject to max_response_time <= 1e9, makespan <= 1e9",
+                             objective, error));
+    TuneSpace space;
+    space.algorithms = ALGORITHMS;
+    TuneOptions options;
+    options.candidates = 48;
+    options.seed = baseSeed;
+    
+    // Rung fronts are promoted, so several trade-offs finish; every complete
+    // candidate is on the final front or weakly dominated by a member of it
+    auto point = [](const TuneMetrics& m) {
+        return std::vector<double>{m.avgWaitingTime, m.maxResponseTime, m.makespan};
+    };
+    auto weaklyDominates = [](const std::vector<double>& a, const std::vector<double>& b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] > b[i]) return false;
+        }
+        return true;
+    };
+    for (const auto& workload : listWorkloads()) {
+        Scenario s;
+        CHECK(generateWorkload(workload.name, 60, baseSeed, s));
+        TuneResult result = tuneScenario(s, objective, space, options);
+        CHECK(!result.pareto.empty());
+        for (size_t c = 0; c < result.candidates.size(); ++c) {
+            if (!result.candidates[c].metrics.complete) continue;
+            bool covered = false;
+            for (int f : result.pareto) {
+                covered = covered || weaklyDominates(point(result.candidates[f].metrics),
+                                                     point(result.candidates[c].metrics));
+            }
+            CHECK(covered);
+        }
+        for (int a : result.pareto) {
+            for (int b : result.pareto) {
+                CHECK(a == b || !weaklyDominates(point(result.candidates[a].metrics),
+                                                 point(result.candidates[b].metrics)));
+            }
+        }
+    }
+}
+
+void testTuneObjectiveParser() {
+    TuneObjective o;
+    std::string error;
+    CHECK(parseTuneObjective("maximize throughput subject to p99_response_time<=40, avg_waiting_time <= 12.5", o, error));
+    CHECK(o.maximize && o.metric == "throughput");
+    CHECK(o.constraints.size() == 2);
+    if (o.constraints.size() == 2) {
+        CHECK(o.constraints[0].metric == "p99_response_time" && !o.constraints[0].atLeast);
+        CHECK(o.constraints[1].bound == 12.5);
+    }
+    CHECK(parseTuneObjective("minimize makespan", o, error) && o.constraints.empty());
+
+    const char* bad[] = {"", "reduce makespan", "minimize speed", "minimize makespan subject to",
+                         "minimize makespan such that throughput >= 1", "minimize makespan subject to throughput > 1",
+                         "minimize makespan subject to throughput >= x"};
+    for (const char* text : bad) {
+        error.clear();
+        CHECK(!parseTuneObjective(text, o, error) && !error.empty());
+    }
+}
+
+// === Priority expressions ===
+
+Trace runExpression(const Scenario& s, const std::string& algorithm, const std::string& expression) {
+    Scheduler scheduler;
+    applyScenario(s, scheduler);
+    scheduler.setAlgorithm(algorithm);
+    if (!scheduler.setPriorityExpression(expression).empty()) throw std::runtime_error("bad expression");
+    return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+}
+
+/**
+ * An expression ordering ready processes exactly like a built-in algorithm
+ * must produce the same schedule and state hash
+ */
+Engine expressionEngine(const std::string& algorithm, const std::string& expression) {
+    return {algorithm + " \"" + expression + "\"", [algorithm, expression](const Scenario& s) {
+        return runExpression(s, algorithm, expression);
+    }};
+}
+
+void testExpressionMatchesBuiltIns() {
+    checkEquivalent(expressionEngine("Expr", "burst"), {"SJF"});
+    checkEquivalent(expressionEngine("ExprP", "remaining"), {"SRTF"});
+    checkEquivalent(expressionEngine("Expr", "priority"), {"PriorityNP"});
+    checkEquivalent(expressionEngine("ExprP", "priority"), {"Priority"});
+}
+
+void testExpressionHeapMatchesScan() {
+    // "+ 0 * now" keeps the value but makes the expression time-variant (full re-scan)
+    const char* expressions[] = {"priority * 2 + remaining / burst", "-executed", "min(burst, 3) - id / 100"};
+    for (const char* algorithm : {"Expr", "ExprP"}) {
+        for (const char* expression : expressions) {
+            for (int i = 0; i < casesPerEngine / 10; ++i) {
+                Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+                Trace heap = runExpression(s, algorithm, expression);
+                Trace scan = runExpression(s, algorithm, std::string(expression) + " + 0 * now");
+                std::string mismatch = compareTraces(scan, heap);
+                if (!mismatch.empty()) {
+                    failures++;
+                    std::cerr << "  " << algorithm << " \"" << expression << "\" heap differs from scan: "
+                              << mismatch << "\n" << formatScenario(s);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * HRRN as the single class of a multilevel queue: the class queue is sorted by
+ * response ratio at every decision instead of kept in the kinetic heap
+ */
+Trace runResponseRatioScan(const Scenario& s) {
+    Scheduler scheduler;
+    applyScenario(s, scheduler);
+    scheduler.setAlgorithm("MLQ");
+    scheduler.addQueueClass(s.config.algorithm, s.config.timeQuantum, 1);
+    return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+}
+
+void testResponseRatioMatchesScan() {
+    checkEquivalent({"MLQ HRRN class", runResponseRatioScan}, {"HRRN", "HRRNP"});
+
+    // Long queues exercise deep heaps and many certificate failures
+    for (const auto& workload : listWorkloads()) {
+        Scenario s;
+        CHECK(generateWorkload(workload.name, 400, baseSeed, s));
+        s.config.agingEnabled = false;
+        for (const char* algorithm : {"HRRN", "HRRNP"}) {
+            s.config.algorithm = algorithm;
+            std::string mismatch = compareTraces(runResponseRatioScan(s), runReference(s));
+            if (!mismatch.empty()) {
+                failures++;
+                std::cerr << "  " << algorithm << " on " << workload.name << " differs from scan: " << mismatch << "\n";
+            }
+        }
+    }
+}
+
+// === Burst prediction ===
+
+void testBurstPredictionLearnsPerName() {
+    // One "job" at a time: every prediction sees the previous bursts only
+    Scheduler scheduler;
+    scheduler.setAlgorithm("SJF");
+    scheduler.setBurstPredictor("EWMA", 0.5);
+    scheduler.setInitialBurstGuess(4);
+    scheduler.addProcess(1, "job", 0, 8, 1);
+    scheduler.addProcess(2, "job", 10, 4, 1);
+    scheduler.addProcess(3, "job", 20, 6, 1);
+    scheduler.addProcess(4, "other", 30, 2, 1);
+    while (!scheduler.isFinished()) scheduler.tick();
+
+    CHECK(scheduler.getProcess(1)->predictedBurst == 4);   // Initial guess
+    CHECK(scheduler.getProcess(2)->predictedBurst == 8);   // First observation
+    CHECK(scheduler.getProcess(3)->predictedBurst == 6);   // 0.5 * 4 + 0.5 * 8
+    CHECK(scheduler.getProcess(4)->predictedBurst == 6);   // Unseen name: all bursts 8, 4, 6
+
+    nlohmann::json prediction = scheduler.getStateJSON()["prediction"];
+    CHECK(prediction["predicted"] == 4);
+    CHECK(prediction["mean_abs_error"] == (4 + 4 + 0 + 4) / 4.0);
+
+    // Prediction is the only thing the ordering sees: "long" has only been seen short
+    Scheduler misled;
+    misled.setAlgorithm("SJF");
+    misled.setBurstPredictor("Quantile", 0.5);
+    misled.addProcess(1, "long", 0, 1, 1);
+    misled.addProcess(2, "short", 1, 5, 1);
+    misled.addProcess(3, "long", 10, 9, 1);
+    misled.addProcess(4, "short", 10, 3, 1);
+    while (!misled.isFinished()) misled.tick();
+    CHECK(misled.getProcess(3)->predictedBurst == 1);
+    CHECK(misled.getProcess(4)->predictedBurst == 5);
+    CHECK(misled.getProcess(3)->startTime < misled.getProcess(4)->startTime);
+}
+
+void testPredictionRegretNonNegativeForSRTF() {
+    // SRTF with true bursts minimizes average waiting (sweep jobs switch for free)
+    for (const auto& workload : listWorkloads()) {
+        Scenario s;
+        CHECK(generateWorkload(workload.name, 200, baseSeed, s));
+        s.config.algorithm = "SRTF";
+        s.config.agingEnabled = false;
+        for (const char* predictor : {"EWMA", "Quantile"}) {
+            SweepJob job = s.config;
+            job.predictor = predictor;
+            SweepResult r = runSweepJob(s.processes, job);
+            CHECK(r.regret >= -1e-9);
+            CHECK(r.predictionError >= 0);
+            CHECK(r.ticks == runSweepJob(s.processes, s.config).ticks);
+        }
+    }
+}
+
+void testExpressionCompiler() {
+    PriorityExpr expr;
+    std::string error;
+    double fields[PriorityExpr::FIELD_COUNT] = {7, 3, 1, 10, 4, 6, 2, 5, 6};
+
+    CHECK(expr.compile("priority * 2 + remaining / burst - age", error));
+    CHECK(expr.evaluate(fields) == 3 * 2 + 4.0 / 10 - 5);
+    CHECK(!expr.isTimeInvariant());
+    CHECK(expr.compile("-(2 * 3) + max(burst, abs(-12)) - min(id, 1.5)", error));
+    CHECK(expr.evaluate(fields) == -6 + 12 - 1.5);
+    CHECK(expr.isTimeInvariant());
+    CHECK(expr.compile("2 * 3 - 1", error));
+    CHECK(expr.evaluate(fields) == 5);
+
+    // Errors leave the last good expression in place
+    CHECK(!expr.compile("priority +", error));
+    CHECK(error == "column 11: unexpected end of expression");
+    CHECK(!expr.compile("burst * speed", error));
+    CHECK(error == "column 9: unknown field 'speed'");
+    CHECK(!expr.compile("min(burst)", error));
+    CHECK(error.find("min() takes 2 arguments") != std::string::npos);
+    CHECK(!expr.compile("(burst", error));
+    CHECK(!expr.compile("burst )", error));
+    CHECK(!expr.compile("", error));
+    CHECK(!expr.compile(std::string(10000, '('), error));
+    CHECK(expr.text() == "2 * 3 - 1");
+
+    Scheduler scheduler;
+    CHECK(!scheduler.setPriorityExpression("burst +* 2").empty());
+    sched_handle* h = sched_create();
+    CHECK(sched_set_priority_expression(h, "waiting -", 1) == SCHED_E_PARSE);
+    CHECK(sched_set_priority_expression(h, "-waiting", 1) == SCHED_OK);
+    sched_destroy(h);
+}
+
+// === Policy plug-ins ===
+
+/**
+ * Linked-in policy that only observes: counts hook calls, dispatches nothing itself
+ */
+struct ObserverState {
+    int ticks = 0;
+    int completions = 0;
+    bool sawRunning = false;
+};
+
+ObserverState observed;
+
+int createObserver(uint32_t, sched_policy* out) {
+    out->abi_version = SCHED_POLICY_ABI_VERSION;
+    out->hooks = SCHED_POLICY_HOOK_TICK | SCHED_POLICY_HOOK_COMPLETE;
+    out->name = "observer";
+    out->state = &observed;
+    out->on_tick = [](void* state, const sched_policy_view* view) {
+        static_cast<ObserverState*>(state)->ticks++;
+        if (view->running) static_cast<ObserverState*>(state)->sawRunning = true;
+    };
+    out->on_complete = [](void* state, const sched_policy_process* p, int64_t now) {
+        if (p->remaining == 0 && now > p->arrival) static_cast<ObserverState*>(state)->completions++;
+    };
+    return 0;
+}
+
+#ifdef SRTF_POLICY_PATH
+void testPluginSRTFMatchesBuiltIn() {
+    checkEquivalent({"plug-in " SRTF_POLICY_PATH, [](const Scenario& s) {
+        std::string error;
+        std::shared_ptr<PolicyInstance> policy = loadPolicy(SRTF_POLICY_PATH, error);
+        if (!policy) throw std::runtime_error(error);
+        Scheduler scheduler;
+        applyScenario(s, scheduler);
+        scheduler.setPolicy(policy);
+        return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+    }}, {"SRTF"});
+}
+#endif
+
+void testPluginHooksOnlyWhenDeclared() {
+    // Without select/preempt the plug-in path dispatches exactly like FCFS
+    checkEquivalent({"observer plug-in", [](const Scenario& s) {
+        std::string error;
+        Scheduler scheduler;
+        applyScenario(s, scheduler);
+        scheduler.setPolicy(createPolicy(createObserver, error));
+        return runScheduler(scheduler, [](Scheduler& sch) { sch.tick(); return true; });
+    }}, {"FCFS"});
+
+    Scenario s = randomScenario(baseSeed, {"FCFS"});
+    std::string error;
+    observed = ObserverState();
+    Scheduler scheduler;
+    applyScenario(s, scheduler);
+    scheduler.setPolicy(createPolicy(createObserver, error));
+    while (!scheduler.isFinished()) scheduler.tick();
+    CHECK(observed.ticks == scheduler.getCurrentTime());
+    CHECK(observed.completions == static_cast<int>(s.processes.size()));
+    CHECK(observed.sawRunning);
+    
+    // Decisions name the plug-in, and keep the name after it is replaced
+    Scheduler recorded;
+    recorded.setPolicy(createPolicy(createObserver, error));
+    recorded.addProcess(1, "A", 0, 1, 0);
+    recorded.setExplainCapacity(4);
+    while (!recorded.isFinished()) recorded.tick();
+    recorded.setPolicy(nullptr);
+    std::vector<DecisionRecord> decisions = recorded.getDecisions(0, 4);
+    CHECK(decisions.size() == 1 && std::string(decisions[0].rule) == "plugin:observer");
+}
+
+void testPluginRejectsBadTables() {
+    std::string error;
+    CHECK(!createPolicy([](uint32_t, sched_policy* out) {
+        out->abi_version = SCHED_POLICY_ABI_VERSION + 1;
+        out->name = "future";
+        return 0;
+    }, error));
+    CHECK(error.find("ABI version") != std::string::npos);
+    CHECK(!createPolicy([](uint32_t, sched_policy* out) {
+        out->abi_version = SCHED_POLICY_ABI_VERSION;
+        out->hooks = SCHED_POLICY_HOOK_SELECT;
+        out->name = "hollow";
+        return 0;
+    }, error));
+    CHECK(error.find("hollow") != std::string::npos);
+
+#ifdef SRTF_POLICY_PATH
+    CHECK(!loadPolicy("/nonexistent/policy.so", error));
+    sched_handle* h = sched_create();
+    CHECK(sched_set_policy_plugin(h, "/nonexistent/policy.so") == SCHED_E_PLUGIN);
+    CHECK(sched_set_policy_plugin(h, SRTF_POLICY_PATH) == SCHED_OK);
+    sched_destroy(h);
+#endif
+}
+
+// === State hash ===
+
+void testHashStreamsAgreeAcrossRuns() {
+    for (int i = 0; i < casesPerEngine / 10; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        HashStream a = recordHashStream(s, 3);
+        HashStream b = recordHashStream(s, 3);
+        CHECK(!compareHashStreams(a, b).diverged);
+        CHECK(a.finished);
+
+        HashStream parsed;
+        std::string error;
+        CHECK(parseHashStream(formatHashStream(a), parsed, error));
+        CHECK(!compareHashStreams(a, parsed).diverged);
+    }
+}
+
+/**
+ * Like recordHashStream, but the run switches algorithm at tick 'switchAt'
+ * (a stand-in for a build that diverges mid-run)
+ */
+HashStream recordSwitching(const Scenario& s, SimTime switchAt, SimTime from, SimTime to, SimTime every) {
+    Scheduler scheduler;
+    applyScenario(s, scheduler);
+    HashStream stream;
+    SimTime tick = 0;
+    if (from == 0) stream.checkpoints.push_back({0, scheduler.getStateHash()});
+    while (!scheduler.isFinished() && (to < 0 || tick < to)) {
+        if (tick == switchAt) scheduler.setAlgorithm(s.config.algorithm == "SJF" ? "FCFS" : "SJF");
+        scheduler.tick();
+        tick++;
+        bool last = scheduler.isFinished();
+        if (tick >= from && (tick % every == 0 || tick == from || tick == to || last)) {
+            stream.checkpoints.push_back({tick, scheduler.getStateHash()});
+            stream.finished = last;
+        }
+    }
+    return stream;
+}
+
+void testBisectFindsFirstDivergentTick() {
+    int diverging = 0;
+    for (int i = 0; i < casesPerEngine / 10; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        SimTime switchAt = i % 7;
+
+        // Brute force: first tick whose per-tick hash differs
+        HashDivergence expected = compareHashStreams(recordHashStream(s, 1), recordSwitching(s, switchAt, 0, -1, 1));
+        HashDivergence found = bisectDivergence(
+            [&](SimTime from, SimTime to, SimTime every) { return recordHashStream(s, every, from, to); },
+            [&](SimTime from, SimTime to, SimTime every) { return recordSwitching(s, switchAt, from, to, every); },
+            8);
+        CHECK(found.diverged == expected.diverged);
+        if (expected.diverged) {
+            diverging++;
+            CHECK(expected.exact);
+            CHECK(found.exact);
+            CHECK(found.firstDiffer == expected.firstDiffer);
+            CHECK(found.firstDiffer > switchAt);
+        }
+    }
+    CHECK(diverging > 0);
+
+    // Different inputs show up before the first tick
+    Scenario s = randomScenario(baseSeed, ALGORITHMS);
+    Scenario changed = s;
+    changed.processes.back().burstTime += 1;
+    CHECK(compareHashStreams(recordHashStream(s, 8), recordHashStream(changed, 8)).firstDiffer == 0);
+}
+
+// === C ABI ===
+
+/**
+ * Load a scenario through the columnar C entry points
+ */
+sched_handle* loadThroughCApi(const Scenario& s) {
+    sched_handle* h = sched_create();
+    sched_set_time_resolution(h, s.timeResolution);
+    sched_set_context_switch(h, s.contextSwitchCost);
+    sched_set_algorithm(h, s.config.algorithm.c_str());
+    sched_set_time_quantum(h, s.config.timeQuantum);
+    sched_set_aging(h, s.config.agingEnabled, s.config.agingThreshold, s.config.agingBoostAmount);
+
+    std::vector<int32_t> ids, priority;
+    std::vector<double> arrival, burst;
+    for (const auto& p : s.processes) {
+        ids.push_back(p.id);
+        arrival.push_back(p.arrivalTime);
+        burst.push_back(p.burstTime);
+        priority.push_back(p.priority);
+    }
+    sched_load(h, ids.size(), ids.data(), arrival.data(), burst.data(), priority.data(), nullptr);
+    return h;
+}
+
+void testCApiMatchesScheduler() {
+    for (int i = 0; i < casesPerEngine / 10; ++i) {
+        Scenario s = randomScenario(baseSeed + i, ALGORITHMS);
+        Trace expected = runReference(s);
+        sched_handle* h = loadThroughCApi(s);
+        CHECK(sched_process_count(h) == s.processes.size());
+
+        // Run in two chunks to exercise both stop conditions
+        sched_run_result result;
+        CHECK(sched_run_until(h, 3, 0, &result) == SCHED_OK);
+        CHECK(result.finished || result.time == 3);
+        CHECK(sched_run_until(h, -1, DIFF_MAX_TICKS, &result) == SCHED_OK);
+        CHECK(result.finished == !expected.truncated);
+        CHECK(sched_state_hash(h) == expected.stateHash);
+
+        size_t n = sched_finished_count(h);
+        CHECK(n == expected.finished.size());
+        std::vector<int32_t> ids(n);
+        std::vector<double> waiting(n), response(n);
+        CHECK(sched_get_finished(h, 0, n + 5, ids.data(), nullptr, nullptr, nullptr, waiting.data(), nullptr,
+                                 response.data()) == static_cast<int64_t>(n));
+        double resolution = static_cast<double>(s.timeResolution);
+        for (size_t row = 0; row < n && row < expected.finished.size(); ++row) {
+            CHECK(ids[row] == expected.finished[row].id);
+            CHECK(waiting[row] == expected.finished[row].waiting / resolution);
+            CHECK(response[row] == expected.finished[row].response / resolution);
+        }
+        CHECK(sched_get_finished(h, n, 10, ids.data(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr) == 0);
+
+        std::vector<int32_t> state(s.processes.size());
+        CHECK(sched_get_table(h, 0, state.size(), nullptr, state.data(), nullptr, nullptr, nullptr, nullptr,
+                              nullptr) == static_cast<int64_t>(state.size()));
+        for (int32_t st : state) CHECK(expected.truncated || st == SCHED_STATE_FINISHED);
+
+        sched_metrics metrics;
+        CHECK(sched_get_metrics(h, &metrics) == SCHED_OK);
+        CHECK(metrics.finished_count == static_cast<int64_t>(n));
+        CHECK(metrics.makespan == expected.endTime / resolution);
+        sched_destroy(h);
+    }
+}
+
+void testCApiRejectsBadInput() {
+    sched_handle* h = sched_create();
+    CHECK(sched_abi_version() == SCHED_ABI_VERSION);
+    CHECK(sched_set_algorithm(h, "Lottery") == SCHED_E_UNKNOWN_ALGORITHM);
+    CHECK(std::string(sched_last_error(h)).find("Lottery") != std::string::npos);
+    CHECK(sched_set_time_quantum(h, 0) == SCHED_E_INVALID_ARGUMENT);
+    CHECK(sched_set_time_resolution(h, 0) == SCHED_E_INVALID_ARGUMENT);
+
+    // All-or-nothing: the duplicate in row 2 keeps rows 0 and 1 out too
+    int32_t ids[] = {1, 2, 1};
+    double arrival[] = {0, 1, 2};
+    double burst[] = {3, 3, 3};
+    int32_t priority[] = {0, 0, 0};
+    CHECK(sched_load(h, 3, ids, arrival, burst, priority, nullptr) == SCHED_E_DUPLICATE_ID);
+    CHECK(sched_process_count(h) == 0);
+    burst[1] = 0;
+    CHECK(sched_load(h, 2, ids, arrival, burst, priority, nullptr) == SCHED_E_INVALID_ARGUMENT);
+    burst[1] = 0.25;  // Rounds to 0 base units at resolution 1
+    CHECK(sched_load(h, 2, ids, arrival, burst, priority, nullptr) == SCHED_E_INVALID_ARGUMENT);
+    burst[1] = 3;
+    arrival[1] = 1e19;  // Past the SimTime range
+    CHECK(sched_load(h, 2, ids, arrival, burst, priority, nullptr) == SCHED_E_INVALID_ARGUMENT);
+    CHECK(std::string(sched_last_error(h)).find("row 1: arrival out of range") == 0);
+    arrival[1] = 1;
+    CHECK(sched_load(h, 2, ids, arrival, burst, priority, nullptr) == SCHED_OK);
+    CHECK(sched_load(h, 1, ids, arrival, burst, priority, nullptr) == SCHED_E_DUPLICATE_ID);
+    CHECK(sched_load(h, 1, nullptr, arrival, burst, priority, nullptr) == SCHED_E_INVALID_ARGUMENT);
+
+    std::string bad = "{\"format\":\"scheduler-scenario\",\"version\":1}\n{\"id\":9,\"burst\":-1}\n";
+    CHECK(sched_load_scenario(h, bad.data(), bad.size()) == SCHED_E_PARSE);
+    CHECK(std::string(sched_last_error(h)).rfind("line 2:", 0) == 0);
+    CHECK(sched_process_count(h) == 2);
+    CHECK(sched_get_metrics(h, nullptr) == SCHED_E_INVALID_ARGUMENT);
+    CHECK(sched_get_finished(nullptr, 0, 1, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr) ==
+          SCHED_E_INVALID_ARGUMENT);
+    sched_destroy(h);
+}
+
+// First error of a text scenario, as (line, message)
+std::pair<int, std::string> firstScenarioError(const std::string& text) {
+    Scenario s;
+    std::vector<ScenarioError> errors;
+    if (parseScenario(text, s, errors) || errors.empty()) return {-1, ""};
+    return {errors[0].line, errors[0].message};
+}
+
+void testScenarioLoaderReportsErrors() {
+    typedef std::pair<int, std::string> E;
+    std::string header = "{\"format\":\"scheduler-scenario\",\"version\":1}\n";
+    
+    // Line numbers count comments and blank lines
+    CHECK(firstScenarioError(header + "# jobs\n\n{\"id\":4,\"burst\":2}\n{\"id\":4,\"burst\":3}\n") ==
+          E(5, "duplicate id 4 (first defined on line 4)"));
+    CHECK(firstScenarioError(header + "{\"id\":1.5,\"burst\":2}\n") == E(2, "\"id\" must be an integer"));
+    CHECK(firstScenarioError(header + "{\"id\":1,\"burst\":2,\"priority\":0.5}\n") ==
+          E(2, "\"priority\" must be an integer"));
+    CHECK(firstScenarioError(header + "{\"id\":1,\"burst\":2}\n{\"id\":2,\"arrival\":-1,\"burst\":2}\n") ==
+          E(3, "arrival must be a non-negative number"));
+    CHECK(firstScenarioError(header + "{\"id\":1,\"burst\":-2}\n") == E(2, "burst must be a positive number"));
+    
+    // Header and version
+    CHECK(firstScenarioError("# no header\n{\"id\":1,\"burst\":2}\n") ==
+          E(2, "expected a header object with \"format\": \"scheduler-scenario\""));
+    CHECK(firstScenarioError("\n{\"format\":\"scheduler-scenario\",\"version\":3}\n") ==
+          E(2, "unsupported version 3 (this build reads 1..2)"));
+    CHECK(firstScenarioError("# only a comment\n") == E(0, "missing header line"));
+    
+    // Times must fit SimTime after scaling and bursts must keep at least one base unit
+    std::string fine = "{\"format\":\"scheduler-scenario\",\"version\":1,\"config\":{\"time_resolution\":1000}}\n";
+    CHECK(firstScenarioError(fine + "{\"id\":1,\"burst\":0.0004}\n") ==
+          E(2, "burst rounds to 0 at time_resolution 1000"));
+    CHECK(firstScenarioError(fine + "{\"id\":1,\"burst\":1e16}\n") ==
+          E(2, "burst is out of range at time_resolution 1000"));
+    CHECK(firstScenarioError(fine + "{\"id\":1,\"arrival\":1e300,\"burst\":1}\n") ==
+          E(2, "arrival is out of range at time_resolution 1000"));
+    CHECK(firstScenarioError(fine + "{\"id\":1,\"burst\":0.0005}\n") == E(-1, ""));
+    
+    // Errors past SCENARIO_MAX_ERRORS are summarized in one trailing entry
+    std::string many = header;
+    for (size_t i = 0; i < SCENARIO_MAX_ERRORS + 5; ++i) many += "{\"id\":-1,\"burst\":1}\n";
+    Scenario s;
+    std::vector<ScenarioError> errors;
+    CHECK(!parseScenario(many, s, errors));
+    CHECK(errors.size() == SCENARIO_MAX_ERRORS + 1);
+    CHECK(errors.back().line == 0 && errors.back().message == "5 more error(s) not shown");
+    CHECK(errors[SCENARIO_MAX_ERRORS - 1].line == static_cast<int>(SCENARIO_MAX_ERRORS) + 1);
+    
+    // Binary: truncation inside the header and inside a record
+    Scenario two;
+    two.processes = {{1, "a", 0, 2, 0}, {2, "b", 1, 2, 0}};
+    std::string bytes = formatScenarioBinary(two);
+    errors.clear();
+    CHECK(!parseScenarioBinary(bytes.substr(0, 10), s, errors));
+    CHECK(errors.size() == 1 && errors[0].line == 0 && errors[0].message == "truncated header");
+    errors.clear();
+    CHECK(!parseScenarioBinary(bytes.substr(0, bytes.size() - 1), s, errors));
+    CHECK(errors.size() == 1 && errors[0].line == 2 &&
+          errors[0].message == "truncated record at byte " + std::to_string(bytes.size() - 1));
+    CHECK(s.processes.size() == 1);
+    errors.clear();
+    std::string future = bytes;
+    future[4] = 9;
+    CHECK(!parseScenarioBinary(future, s, errors));
+    CHECK(errors.size() == 1 && errors[0].message == "unsupported version 9");
+    errors.clear();
+    CHECK(!parseScenarioBinary("PSCX" + bytes.substr(4), s, errors));
+    CHECK(errors.size() == 1 && errors[0].message == "not a binary scenario (bad magic)");
+}
+
+// === Workflow DAG ===
+
+void testDagReleasesChildrenAfterParents() {
+    // Diamond 1 -> {2, 3} -> 4 plus 5, which arrives after its parent has finished
+    Scheduler scheduler;
+    scheduler.setAlgorithm("FCFS");
+    scheduler.addProcess(1, "extract", 0, 2, 1);
+    scheduler.addProcess(2, "left", 0, 3, 1);
+    scheduler.addProcess(3, "right", 0, 1, 1);
+    scheduler.addProcess(4, "join", 0, 2, 1);
+    scheduler.addProcess(5, "late", 4, 1, 1);
+    CHECK(scheduler.addDependency(1, 2));
+    CHECK(scheduler.addDependency(1, 3));
+    CHECK(scheduler.addDependency(2, 4));
+    CHECK(scheduler.addDependency(3, 4));
+    CHECK(scheduler.addDependency(1, 5));
+    CHECK(!scheduler.addDependency(4, 2));   // Parent added after the child
+    CHECK(!scheduler.addDependency(1, 9));
+    while (!scheduler.isFinished()) scheduler.tick();
+
+    CHECK(scheduler.getProcess(2)->startTime == 2);
+    CHECK(scheduler.getProcess(2)->waitingTime == 0);   // Counted from the release
+    CHECK(scheduler.getProcess(3)->startTime == 5);
+    CHECK(scheduler.getProcess(3)->waitingTime == 3);
+    CHECK(scheduler.getProcess(4)->arrivalTime == 6);
+    CHECK(scheduler.getProcess(4)->turnaroundTime == 3);   // 5 arrived first
+    CHECK(scheduler.getProcess(5)->arrivalTime == 4);
+
+    DagMetrics dag = scheduler.getDagMetrics();
+    CHECK(dag.criticalPath == 7);
+    CHECK(dag.work == 9);
+    CHECK(dag.makespan == 9);
+    CHECK(dag.held == 0);
+    CHECK(dag.slack.size() == 5 && dag.slack[2] == 2 && dag.slack[4] == 2);
+    CHECK((dag.criticalIds == std::vector<int>{1, 2, 4}));
+
+    nlohmann::json state = scheduler.getStateJSON();
+    CHECK(state["dag"]["critical_path"] == 7);
+    CHECK(state["finished"][0]["slack"].is_number());
+}
+
+void testScenarioDependenciesRoundTrip() {
+    Scenario s;
+    CHECK(generateWorkload("pipeline", 60, baseSeed, s));
+    CHECK(!s.dependencies.empty());
+    CHECK(formatScenario(s).find("\"version\":2") != std::string::npos);
+
+    Scenario text, binary;
+    std::vector<ScenarioError> errors;
+    CHECK(parseScenario(formatScenario(s), text, errors));
+    CHECK(parseScenarioBinary(formatScenarioBinary(s), binary, errors));
+    for (const Scenario* copy : {&text, &binary}) {
+        CHECK(copy->dependencies.size() == s.dependencies.size());
+        for (size_t i = 0; i < s.dependencies.size() && i < copy->dependencies.size(); ++i) {
+            CHECK(copy->dependencies[i].parent == s.dependencies[i].parent);
+            CHECK(copy->dependencies[i].child == s.dependencies[i].child);
+        }
+    }
+
+    // Scenarios without dependencies stay readable by version 1 readers
+    Scenario flat;
+    CHECK(generateWorkload("convoy", 10, baseSeed, flat));
+    CHECK(formatScenario(flat).find("\"version\":1") != std::string::npos);
+
+    std::string header = "{\"format\":\"scheduler-scenario\",\"version\":2}\n";
+    std::string procs = "{\"id\":1,\"burst\":2}\n{\"id\":2,\"burst\":2}\n";
+    errors.clear();
+    CHECK(parseScenario(header + procs + "{\"parent\":1,\"child\":2}\n", text, errors));
+    CHECK(!parseScenario(header + procs + "{\"parent\":2,\"child\":1}\n", text, errors));
+    CHECK(errors.size() == 1 && errors[0].line == 4);
+    errors.clear();
+    CHECK(!parseScenario(header + procs + "{\"parent\":1,\"child\":7}\n", text, errors));
+    CHECK(!errors.empty() && errors[0].message.find("unknown id 7") != std::string::npos);
+    CHECK(!parseScenario(header + procs + "{\"parent\":1,\"child\":2,\"burst\":1}\n", text, errors));
+    errors.clear();
+    std::string v1 = "{\"format\":\"scheduler-scenario\",\"version\":1}\n";
+    CHECK(!parseScenario(v1 + procs + "{\"parent\":1,\"child\":2}\n", text, errors));
+    CHECK(!errors.empty() && errors[0].message == "dependencies need version 2");
+}
+
+void testPipelineCriticalPathBoundsMakespan() {
+    Scenario s;
+    CHECK(generateWorkload("pipeline", 300, baseSeed, s));
+    for (const std::string& algorithm : ALGORITHMS) {
+        SweepJob job = s.config;
+        job.algorithm = algorithm;
+        SweepResult r = runSweepJob(s.processes, job, s.dependencies);
+        CHECK(r.criticalPath > 0);
+        CHECK(r.criticalPath <= r.makespan + 1e-9);
+    }
+
+    // Columnar C entry points match the scenario loader
+    Scheduler reference;
+    applyScenario(s, reference);
+    while (!reference.isFinished()) reference.tick();
+    CHECK(reference.getFinishedCount() == s.processes.size());
+
+    sched_handle* h = loadThroughCApi(s);
+    std::vector<int32_t> parents, children;
+    for (const auto& d : s.dependencies) {
+        parents.push_back(d.parent);
+        children.push_back(d.child);
+    }
+    int32_t backwards[] = {children[0]};
+    int32_t forwards[] = {parents[0]};
+    CHECK(sched_add_dependencies(h, 1, backwards, forwards) == SCHED_E_INVALID_ARGUMENT);
+    CHECK(sched_add_dependencies(h, parents.size(), parents.data(), children.data()) == SCHED_OK);
+    CHECK(sched_run_until(h, -1, 0, nullptr) == SCHED_OK);
+    CHECK(sched_state_hash(h) == reference.getStateHash());
+    sched_dag_metrics dag;
+    CHECK(sched_get_dag_metrics(h, &dag) == SCHED_OK);
+    CHECK(dag.critical_path == reference.getDagMetrics().criticalPath);
+    CHECK(dag.held == 0);
+    CHECK(sched_add_dependencies(h, 1, forwards, backwards) == SCHED_E_INVALID_ARGUMENT);   // Already arrived
+    sched_destroy(h);
+}
+
+// === Harness self-checks ===
+
+void testShrinkerFindsMinimalReproducer() {
+    // Fake engine that mis-accounts any process with burst >= 5 and priority >= 3
+    Engine broken = {"broken", [](const Scenario& s) {
+        Trace trace = runReference(s);
+        for (auto& o : trace.finished) {
+            for (const auto& p : s.processes) {
+                if (p.id == o.id && p.burstTime >= 5 && p.priority >= 3) o.waiting++;
+            }
+        }
+        return trace;
+    }};
+    DiffReport report = runDifferential(broken, 200, baseSeed, ALGORITHMS);
+    CHECK(!report.ok);
+    CHECK(report.reproducer.processes.size() == 1);
+    if (report.reproducer.processes.size() == 1) {
+        const ProcessSpec& p = report.reproducer.processes[0];
+        CHECK(p.id == 1);
+        CHECK(p.arrivalTime == 0);
+        CHECK(p.burstTime == 5);
+        CHECK(p.priority == 3);
+    }
+    CHECK(!report.reproducer.config.agingEnabled);
+    CHECK(report.reproducer.contextSwitchCost == 0);
+}
+
+void testCompareTracesReportsFirstDifference() {
+    Trace a, b;
+    a.timeline = {1, 1, 2};
+    b.timeline = {1, 2, 2};
+    CHECK(compareTraces(a, a).empty());
+    CHECK(compareTraces(a, b) == "tick 1: expected process 1, ran 2");
+}
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+const TestCase TESTS[] = {
+    {"runFor matches tick", testRunForMatchesTick},
+    {"scenario round trip matches tick", testScenarioRoundTripMatchesTick},
+    {"parallel sweep matches single jobs", testParallelSweepMatchesSingleJobs},
+    {"process table matches processes", testProcessTableMatchesProcesses},
+    {"timeline capacity keeps the newest ticks", testTimelineCapacityKeepsNewest},
+    {"MLQ default class matches FCFS", testMultilevelDefaultClassMatchesFCFS},
+    {"MLQ strict and time-slice policies", testMultilevelStrictAndTimeSlice},
+    {"lock retaken in one burst", testLockRetakenInOneBurst},
+    {"protocols bound priority inversion", testProtocolsBoundPriorityInversion},
+    {"lookup follows every move", testLookupFollowsEveryMove},
+    {"gang waits for cores and rotates", testGangWaitsForCoresAndRotates},
+    {"gang cores span mask words", testGangCoresSpanMaskWords},
+    {"log ring keeps the newest lines across wraps", testLogRingKeepsNewestAcrossWraps},
+    {"finished pages sort and clamp", testFinishedPagesSortAndClamp},
+    {"decision rules outlive the algorithm", testDecisionRulesOutliveAlgorithm},
+    {"DVFS waiting excludes slowdown", testDvfsWaitingExcludesSlowdown},
+    {"energy and throughput across resolutions", testEnergyAndThroughputAcrossResolutions},
+    {"resolution rescales settings", testResolutionRescalesSettings},
+    {"tuner is deterministic and sound", testTunerDeterministicAndSound},
+    {"tuner front covers complete candidates", testTunerFrontCoversCompleteCandidates},
+    {"tune objective parser", testTuneObjectiveParser},
+    {"expressions match built-ins", testExpressionMatchesBuiltIns},
+    {"expression heap matches scan", testExpressionHeapMatchesScan},
+    {"response ratio heap matches scan", testResponseRatioMatchesScan},
+    {"burst prediction learns per name", testBurstPredictionLearnsPerName},
+    {"prediction regret is non-negative for SRTF", testPredictionRegretNonNegativeForSRTF},
+    {"expression compiler", testExpressionCompiler},
+    {"DAG releases children after parents", testDagReleasesChildrenAfterParents},
+    {"scenario loader reports errors", testScenarioLoaderReportsErrors},
+    {"scenario dependencies round trip", testScenarioDependenciesRoundTrip},
+    {"pipeline critical path bounds makespan", testPipelineCriticalPathBoundsMakespan},
+#ifdef SRTF_POLICY_PATH
+    {"plug-in SRTF matches built-in", testPluginSRTFMatchesBuiltIn},
+#endif
+    {"plug-in hooks only when declared", testPluginHooksOnlyWhenDeclared},
+    {"plug-in rejects bad tables", testPluginRejectsBadTables},
+    {"hash streams agree across runs", testHashStreamsAgreeAcrossRuns},
+    {"bisect finds first divergent tick", testBisectFindsFirstDivergentTick},
+    {"C API matches Scheduler", testCApiMatchesScheduler},
+    {"C API rejects bad input", testCApiRejectsBadInput},
+    {"shrinker finds minimal reproducer", testShrinkerFindsMinimalReproducer},
+    {"compareTraces reports first difference", testCompareTracesReportsFirstDifference},
+};
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) casesPerEngine = std::atoi(argv[1]);
+    if (argc > 2) baseSeed = std::strtoull(argv[2], nullptr, 10);
+
+    int failedTests = 0;
+    for (const auto& test : TESTS) {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        failedTests += passed ? 0 : 1;
+        std::cout << (passed ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+    }
+    std::cout << (sizeof(TESTS) / sizeof(TESTS[0]) - failedTests) << "/" << sizeof(TESTS) / sizeof(TESTS[0])
+              << " tests passed" << std::endl;
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ * CPU Scheduler Simulator - WASM hash recorder (Node)
+ * Runs a text scenario in a WASM build and prints its state-hash stream in the
+ * same format as `scheduler_hashcheck record`, so the two can be compared or
+ * bisected against each other
+ *
+ *   node tools/hash_record.js <scenario.jsonl> [--every K] [--from T] [--to T]
+ *                             [--module www/scheduler_wasm.js]
+ */
+
+const fs = require('fs');
+const path = require('path');
+const vm = require('vm');
+
+function usage() {
+    console.error('Usage: node tools/hash_record.js <scenario.jsonl> [--every K] [--from T] [--to T] [--module FILE]');
+    process.exit(2);
+}
+
+const args = process.argv.slice(2);
+if (args.length < 1) usage();
+const options = { every: 1000, from: 0, to: -1, module: path.join(__dirname, '..', 'www', 'scheduler_wasm.js') };
+for (let i = 1; i < args.length; i += 2) {
+    const key = args[i].replace(/^--/, '');
+    if (!(key in options) || i + 1 >= args.length) usage();
+    options[key] = key === 'module' ? args[i + 1] : parseInt(args[i + 1], 10);
+}
+options.every = Math.max(1, options.every);
+
+function inRange(tick) {
+    return tick >= options.from && (options.to < 0 || tick <= options.to);
+}
+
+/**
+ * Same setup order as applyScenario() in src/scenario.cpp
+ */
+function applyScenario(result) {
+    const config = result.config;
+    const scheduler = new Module.Scheduler();
+    scheduler.setTimeResolution(config.time_resolution);
+    scheduler.setContextSwitchCost(config.context_switch);
+    scheduler.setAlgorithm(config.algorithm);
+    scheduler.setTimeQuantum(config.quantum);
+    scheduler.setAging(config.aging);
+    scheduler.setAgingThreshold(config.aging_threshold);
+    scheduler.setAgingBoostAmount(config.aging_boost);
+    result.processes.forEach(p => scheduler.addProcess(p.id, p.name, p.arrival, p.burst, p.priority));
+    result.dependencies.forEach(d => scheduler.addDependency(d.parent, d.child));
+    return scheduler;
+}
+
+function record() {
+    const result = JSON.parse(Module.parseScenario(fs.readFileSync(args[0], 'utf8')));
+    if (!result.ok) {
+        result.errors.forEach(err => console.error(`${args[0]}:${err.line}: ${err.message}`));
+        process.exit(2);
+    }
+
+    const scheduler = applyScenario(result);
+    const lines = ['# scheduler-hash-stream 1'];
+    let pending = null;  // Last checkpoint, printed with "end" if the run finishes on it
+    const checkpoint = (tick) => {
+        if (pending) lines.push(pending);
+        pending = `${tick} ${scheduler.getStateHash()}`;
+    };
+
+    let tick = 0;
+    if (inRange(0)) checkpoint(0);
+    while (!scheduler.isFinished() && (options.to < 0 || tick < options.to)) {
+        scheduler.tick();
+        tick++;
+        const last = scheduler.isFinished();
+        if (inRange(tick) && (tick % options.every === 0 || tick === options.from || tick === options.to || last)) {
+            checkpoint(tick);
+        }
+    }
+    if (pending) {
+        const ended = scheduler.isFinished() && inRange(tick);
+        lines.push((ended ? 'end ' : '') + pending);
+    }
+    process.stdout.write(lines.join('\n') + '\n');
+    scheduler.delete();
+}
+
+// Non-modularized Emscripten output reads a global Module and Node's require/__dirname
+const modulePath = path.resolve(options.module);
+global.Module = { onRuntimeInitialized: record };
+global.require = require;
+global.__dirname = path.dirname(modulePath);
+global.__filename = modulePath;
+vm.runInThisContext(fs.readFileSync(modulePath, 'utf8'), { filename: modulePath });
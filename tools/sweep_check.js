@@ -0,0 +1,65 @@
+/**
+ * CPU Scheduler Simulator - headless check of the pthreads sweep build (Node)
+ * Runs one sweep on the full worker pool and again on a single thread, checks
+ * that both agree and that a small hand-computed workload has the right metrics.
+ * Exits non-zero on any mismatch (registered with CTest in Emscripten builds)
+ *
+ *   node tools/sweep_check.js [--module www/scheduler_wasm_mt.js]
+ */
+
+const path = require('path');
+
+const args = process.argv.slice(2);
+let modulePath = path.join(__dirname, '..', 'www', 'scheduler_wasm_mt.js');
+if (args.length === 2 && args[0] === '--module') {
+    modulePath = path.resolve(args[1]);
+} else if (args.length !== 0) {
+    console.error('Usage: node tools/sweep_check.js [--module FILE]');
+    process.exit(2);
+}
+
+// A: arrives at 0 with burst 8; B: arrives at 1 with burst 2
+const processes = [
+    { id: 1, name: 'A', arrival: 0, burst: 8, priority: 1 },
+    { id: 2, name: 'B', arrival: 1, burst: 2, priority: 0 }
+];
+const expectedWaiting = { FCFS: 3.5, SJF: 3.5, SRTF: 1, Priority: 1, PriorityNP: 3.5 };
+const algorithms = ['FCFS', 'SJF', 'SRTF', 'RR', 'Priority', 'PriorityNP', 'HRRN', 'HRRNP'];
+
+let failures = 0;
+function check(cond, message) {
+    if (!cond) {
+        console.error(`FAIL: ${message}`);
+        failures++;
+    }
+}
+
+require(modulePath)().then(m => {
+    const request = { processes: processes, jobs: algorithms.map(algorithm => ({ algorithm: algorithm, quantum: 2 })) };
+    const parallel = JSON.parse(m.runSweep(JSON.stringify(request)));
+    const serial = JSON.parse(m.runSweep(JSON.stringify(Object.assign({ threads: 1 }, request))));
+
+    check(!parallel.error && !serial.error, `sweep error: ${parallel.error || serial.error}`);
+    if (failures === 0) {
+        check(parallel.results.length === algorithms.length, `expected ${algorithms.length} results`);
+        check(JSON.stringify(parallel) === JSON.stringify(serial),
+            `${m.getWorkerCount()} threads and 1 thread disagree`);
+        parallel.results.forEach(r => {
+            const expected = expectedWaiting[r.algorithm];
+            if (expected !== undefined) {
+                check(Math.abs(r.avg_waiting_time - expected) < 1e-9,
+                    `${r.algorithm} avg waiting ${r.avg_waiting_time}, expected ${expected}`);
+            }
+            check(r.makespan === 10, `${r.algorithm} makespan ${r.makespan}, expected 10`);
+        });
+    }
+
+    const invalid = JSON.parse(m.runSweep('{'));
+    check(invalid.error === 'invalid request JSON', 'malformed request must report an error');
+
+    console.log(failures === 0 ? `sweep_check: ok (${m.getWorkerCount()} threads)` : `sweep_check: ${failures} failure(s)`);
+    process.exit(failures === 0 ? 0 : 1);
+}, e => {
+    console.error(`sweep_check: cannot load ${modulePath}: ${e}`);
+    process.exit(2);
+});
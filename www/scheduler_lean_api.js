@@ -0,0 +1,134 @@
+/**
+ * CPU Scheduler Simulator - Lean Build Adapter
+ * Appended to scheduler_wasm_lean.js with --post-js; recreates the embind
+ * Scheduler interface used by script.js on top of the raw C exports.
+ * State is read through getStateFrame()/getProcessTable() (there is no getStateJSON),
+ * and module-level helpers such as parseScenario are absent: script.js feature-detects them.
+ */
+
+// Column ids of sched_table_column, in wasm_lean_main.cpp TableColumn order
+const LEAN_TABLE_COLUMNS = [
+    ['ids', Int32Array], ['state', Int32Array], ['remaining', Float64Array], ['priority', Int32Array],
+    ['waiting', Float64Array], ['turnaround', Float64Array], ['response', Float64Array],
+    ['readyOrder', Int32Array]
+];
+
+Module['Scheduler'] = class {
+    constructor() {
+        this.handle = Module['_sched_create']();
+    }
+
+    withString(text, fn) {
+        const ptr = Module['stringToNewUTF8'](text);
+        try {
+            return fn(ptr);
+        } finally {
+            Module['_free'](ptr);
+        }
+    }
+
+    addProcess(id, name, arrival, burst, priority) {
+        return !!this.withString(name, ptr => Module['_sched_add_process'](this.handle, id, ptr, arrival, burst, priority));
+    }
+
+    addDependency(parentId, childId) {
+        return Module['_sched_add_dependency'](this.handle, parentId, childId) !== 0;
+    }
+
+    setTimeResolution(unitsPerTime) {
+        Module['_sched_set_time_resolution'](this.handle, unitsPerTime);
+    }
+
+    setContextSwitchCost(cost) {
+        Module['_sched_set_context_switch_cost'](this.handle, cost);
+    }
+
+    setAlgorithm(algo) {
+        this.withString(algo, ptr => Module['_sched_set_algorithm'](this.handle, ptr));
+    }
+
+    setTimeQuantum(q) {
+        Module['_sched_set_time_quantum'](this.handle, q);
+    }
+
+    setAging(enabled) {
+        Module['_sched_set_aging'](this.handle, enabled ? 1 : 0);
+    }
+
+    setAgingThreshold(threshold) {
+        Module['_sched_set_aging_threshold'](this.handle, threshold);
+    }
+
+    setAgingBoostAmount(amount) {
+        Module['_sched_set_aging_boost_amount'](this.handle, amount);
+    }
+
+    setPriorityExpression(text) {
+        return this.withString(text, ptr =>
+            Module['UTF8ToString'](Module['_sched_set_priority_expression'](this.handle, ptr)));
+    }
+
+    setBurstPredictor(predictor, param) {
+        this.withString(predictor, ptr => Module['_sched_set_burst_predictor'](this.handle, ptr, param));
+    }
+
+    setRecordTimeline(enabled) {
+        Module['_sched_set_record_timeline'](this.handle, enabled ? 1 : 0);
+    }
+
+    tick() {
+        return Module['UTF8ToString'](Module['_sched_tick'](this.handle));
+    }
+
+    runFor(budgetMs, maxTicks) {
+        const log = Module['UTF8ToString'](Module['_sched_run_for'](this.handle, budgetMs, maxTicks));
+        const s = Module['_sched_run_summary'](this.handle) >> 3;
+        return { 'ticks': HEAPF64[s], 'time': HEAPF64[s + 1], 'finished': HEAPF64[s + 2] !== 0,
+                 'elapsedMs': HEAPF64[s + 3], 'log': log };
+    }
+
+    isFinished() {
+        return Module['_sched_is_finished'](this.handle) !== 0;
+    }
+
+    getStateFrame() {
+        const f = Module['_sched_get_state_frame'](this.handle) >> 3;
+        return { 'time': HEAPF64[f], 'lastExecutedId': HEAPF64[f + 1], 'cpuId': HEAPF64[f + 2],
+                 'cpuRemaining': HEAPF64[f + 3], 'readyCount': HEAPF64[f + 4], 'finishedCount': HEAPF64[f + 5] };
+    }
+
+    getStateVersion() {
+        return Module['_sched_get_state_version'](this.handle) >>> 0;
+    }
+
+    /**
+     * Typed-array views into the engine's columns, as the embind getProcessTable()
+     * HEAP32 is read per call because memory growth replaces the buffer
+     */
+    getProcessTable() {
+        const rows = Module['_sched_sync_table'](this.handle);
+        const views = { 'version': this.getStateVersion() };
+        LEAN_TABLE_COLUMNS.forEach(([name, Type], column) => {
+            views[name] = new Type(HEAP32.buffer, Module['_sched_table_column'](this.handle, column), rows);
+        });
+        return views;
+    }
+
+    setTimelineCapacity(ticks) {
+        Module['_sched_set_timeline_capacity'](this.handle, ticks);
+    }
+
+    getTimelineStart() {
+        return Module['_sched_timeline_start'](this.handle);
+    }
+
+    getTimeline() {
+        return new Int32Array(HEAP32.buffer, Module['_sched_timeline_data'](this.handle),
+                              Module['_sched_timeline_size'](this.handle));
+    }
+
+    delete() {
+        Module['_sched_destroy'](this.handle);
+        this.handle = 0;
+    }
+};
@@ -6,18 +6,42 @@
 // === State Management ===
 let scheduler = null;
 let processes = [];
-let processIdCounter = 1;
+let processIndexById = new Map();  // Process id -> index in 'processes' (= engine slot)
+let timeResolution = 1;     // Ticks per time unit, from the last scenario file
+let contextSwitchCost = 0;  // Time units per switch, from the last scenario file
+let scenarioDependencies = [];  // {parent, child} edges from the last scenario file
 let isPlaying = false;
 let playInterval = null;
 let ganttData = [];         // Track Gantt blocks for merging
 let priorityCache = {};     // Cache priority values when column is hidden
 
+// Worker mode: simulation runs in sim_worker.js, state arrives via SharedArrayBuffer
+let simWorker = null;
+let workerReady = false;
+let workerSession = false;  // Current run is hosted by the worker
+let shared = null;          // SimShared views over the shared buffer
+let readSeq = 0;            // Ring frames consumed so far
+let frameHandle = null;     // requestAnimationFrame id, null while not draining
+let workerRunning = false;  // Worker may still publish frames; keep draining
+
+const FAST_FRAME_BUDGET_MS = 8;  // Engine time per frame at full speed (main thread)
+let fastFrameHandle = null;
+
+const LOG_RETAINED = 100000;    // Tick logs the engine keeps for paging
+const LOG_PAGE = 200;           // Log lines in the DOM at once
+let logPageFrom = null;         // Start time of the page on display, null while following live output
+let simTime = 0;                // Time of the last rendered state
+
 const elements = {
     // Algorithm Settings
     algorithmSelect: document.getElementById('algorithmSelect'),
     algorithmSelectSim: document.getElementById('algorithmSelectSim'),
     timeQuantum: document.getElementById('timeQuantum'),
     quantumContainer: document.getElementById('quantumContainer'),
+    expressionContainer: document.getElementById('expressionContainer'),
+    priorityExpression: document.getElementById('priorityExpression'),
+    predictorContainer: document.getElementById('predictorContainer'),
+    burstPredictor: document.getElementById('burstPredictor'),
     enableAging: document.getElementById('enableAging'),
     enableAgingSim: document.getElementById('enableAgingSim'),
     agingContainer: document.getElementById('agingContainer'),
@@ -48,6 +72,7 @@ const elements = {
     playBtn: document.getElementById('playBtn'),
     pauseBtn: document.getElementById('pauseBtn'),
     resetBtn: document.getElementById('resetBtn'),
+    compareBtn: document.getElementById('compareBtn'),
     speedSlider: document.getElementById('speedSlider'),
     
     // Results
@@ -57,13 +82,18 @@ const elements = {
     resultsTableBody: document.getElementById('resultsTableBody'),
     
     // Log
-    executionLog: document.getElementById('executionLog')
+    executionLog: document.getElementById('executionLog'),
+    logPaging: document.getElementById('logPaging'),
+    logOlderBtn: document.getElementById('logOlderBtn'),
+    logNewerBtn: document.getElementById('logNewerBtn'),
+    logLiveBtn: document.getElementById('logLiveBtn')
 };
 
 // === Module Initialization ===
 window.initializeApp = function() {
     console.log("Initializing App...");
     initializeTheme(); // Set initial theme
+    initializeWorker();
     setupEventListeners();
     updateAlgorithmUI();
     addProcessRow(); // Start with one empty row
@@ -90,6 +120,13 @@ function setupEventListeners() {
     elements.playBtn.addEventListener('click', startPlayback);
     elements.pauseBtn.addEventListener('click', pausePlayback);
     elements.resetBtn.addEventListener('click', resetSimulation);
+    elements.speedSlider.addEventListener('input', onSpeedChange);
+    elements.compareBtn.addEventListener('click', compareAlgorithms);
+    
+    // Log paging
+    elements.logOlderBtn.addEventListener('click', showOlderLog);
+    elements.logNewerBtn.addEventListener('click', showNewerLog);
+    elements.logLiveBtn.addEventListener('click', showLiveLog);
 
     // Theme toggle
     elements.themeToggle.addEventListener('click', toggleTheme);
@@ -132,8 +169,10 @@ function onAlgorithmChangeSim() {
 
 function updateAlgorithmUI() {
     const algo = elements.algorithmSelect.value;
-    const isPriority = algo === 'Priority' || algo === 'PriorityNP';
+    const isExpression = algo === 'Expr' || algo === 'ExprP';
+    const isPriority = algo === 'Priority' || algo === 'PriorityNP' || isExpression;
     const isRR = algo === 'RR';
+    const usesBursts = algo === 'SJF' || algo === 'SRTF';
     
     // Toggle Quantum UI
     if (isRR) {
@@ -142,6 +181,20 @@ function updateAlgorithmUI() {
         elements.quantumContainer.classList.remove('visible');
     }
     
+    // Toggle Expression UI
+    if (isExpression) {
+        elements.expressionContainer.classList.add('visible');
+    } else {
+        elements.expressionContainer.classList.remove('visible');
+    }
+    
+    // Toggle Burst Prediction UI
+    if (usesBursts) {
+        elements.predictorContainer.classList.add('visible');
+    } else {
+        elements.predictorContainer.classList.remove('visible');
+    }
+    
     // Toggle Aging UI
     if (isPriority) {
         elements.agingContainer.classList.add('visible');
@@ -207,21 +260,42 @@ function restorePriorityValues() {
 // === Process Table Management ===
 function addProcessRow() {
     const rowCount = elements.processTableBody.querySelectorAll('tr').length;
-    const nextName = `P${rowCount + 1}`;
-    
+    appendProcessRow(nextProcessId(), `P${rowCount + 1}`, 0, 5, 0);
+    updateProcessCount();
+    syncProcessesFromTable();
+    updateResultsTable();
+}
+
+/**
+ * Smallest id above every id in the table
+ */
+function nextProcessId() {
+    let max = 0;
+    elements.processTableBody.querySelectorAll('tr').forEach(row => {
+        max = Math.max(max, parseInt(row.dataset.id) || 0);
+    });
+    return max + 1;
+}
+
+/**
+ * Append one editable row; values are set through the DOM, never as markup,
+ * since names come from user files
+ */
+function appendProcessRow(id, name, arrival, burst, priority) {
     const row = document.createElement('tr');
+    row.dataset.id = id;
     row.innerHTML = `
-        <td><input type="text" class="name-input" value="${nextName}" placeholder="Name"></td>
-        <td><input type="number" class="arrival-input" value="0" min="0"></td>
-        <td><input type="number" class="burst-input" value="5" min="1"></td>
-        <td class="priority-col"><input type="number" class="priority-input" value="0" min="0"></td>
+        <td><input type="text" class="name-input" placeholder="Name"></td>
+        <td><input type="number" class="arrival-input" min="0" step="any"></td>
+        <td><input type="number" class="burst-input" min="0" step="any"></td>
+        <td class="priority-col"><input type="number" class="priority-input" min="0"></td>
         <td class="action-col"><button class="delete-btn" onclick="removeProcessRow(this)">×</button></td>
     `;
-    
+    row.querySelector('.name-input').value = name;
+    row.querySelector('.arrival-input').value = arrival;
+    row.querySelector('.burst-input').value = burst;
+    row.querySelector('.priority-input').value = priority;
     elements.processTableBody.appendChild(row);
-    updateProcessCount();
-    syncProcessesFromTable();
-    updateResultsTable();
 }
 
 function removeProcessRow(btn) {
@@ -254,17 +328,20 @@ function updateProcessCount() {
 
 function syncProcessesFromTable() {
     processes = [];
+    processIndexById = new Map();
     const rows = elements.processTableBody.querySelectorAll('tr');
     
     rows.forEach((row, index) => {
+        const id = parseInt(row.dataset.id);
         const name = row.querySelector('.name-input').value.trim() || `P${index + 1}`;
-        const arrival = parseInt(row.querySelector('.arrival-input').value) || 0;
-        const burst = parseInt(row.querySelector('.burst-input').value) || 1;
+        const arrival = Math.max(0, parseFloat(row.querySelector('.arrival-input').value) || 0);
+        const burst = parseFloat(row.querySelector('.burst-input').value) || 1;
         const priorityInput = row.querySelector('.priority-input');
         const priority = priorityInput ? (parseInt(priorityInput.value) || 0) : 0;
         
+        processIndexById.set(id, index);
         processes.push({
-            id: index + 1,
+            id: id,
             name: name,
             arrival: arrival,
             burst: burst,
@@ -280,6 +357,10 @@ function handleCsvUpload(event) {
     
     const reader = new FileReader();
     reader.onload = function(e) {
+        if (file.name.endsWith('.jsonl')) {
+            loadScenarioText(e.target.result);
+            return;
+        }
         const lines = e.target.result.split('\n');
         
         lines.forEach((line, index) => {
@@ -287,8 +368,10 @@ function handleCsvUpload(event) {
             
             const parts = line.split(',').map(p => p.trim());
             if (parts.length >= 4) {
-                addProcessRowWithData(
-                    parts[1] || `P${processIdCounter}`,
+                const rowCount = elements.processTableBody.querySelectorAll('tr').length;
+                appendProcessRow(
+                    nextProcessId(),
+                    parts[1] || `P${rowCount + 1}`,
                     parseInt(parts[2]) || 0,
                     parseInt(parts[3]) || 1,
                     parseInt(parts[4]) || 0
@@ -296,27 +379,69 @@ function handleCsvUpload(event) {
             }
         });
         
+        updateProcessCount();
         updateResultsTable();
     };
     reader.readAsText(file);
     event.target.value = '';
 }
 
-function addProcessRowWithData(name, arrival, burst, priority) {
-    const row = document.createElement('tr');
-    
-    row.innerHTML = `
-        <td><input type="text" class="name-input" value="${name}" placeholder="Name"></td>
-        <td><input type="number" class="arrival-input" value="${arrival}" min="0"></td>
-        <td><input type="number" class="burst-input" value="${burst}" min="1"></td>
-        <td class="priority-col"><input type="number" class="priority-input" value="${priority}" min="0"></td>
-        <td><button class="delete-btn" onclick="removeProcessRow(this)">×</button></td>
-    `;
-    
-    elements.processTableBody.appendChild(row);
-    processIdCounter++;
+// === Scenario Files ===
+/**
+ * Replace the workload and settings with a validated scenario (.jsonl)
+ * Nothing is changed if the engine reports any error
+ */
+function loadScenarioText(text) {
+    if (typeof Module === 'undefined' || !Module.Scheduler) {
+        alert('Error: WASM module not loaded. Please refresh the page.');
+        return;
+    }
+    if (!Module.parseScenario) {
+        alert('Scenario files need the full build (this page loaded scheduler_wasm_lean).');
+        return;
+    }
+    const result = JSON.parse(Module.parseScenario(text));
+    if (!result.ok) {
+        const lines = result.errors.map(err => (err.line > 0 ? `Line ${err.line}: ` : '') + err.message);
+        alert(`Scenario has ${result.errors.length} error(s):\n` + lines.join('\n'));
+        return;
+    }
+
+    const config = result.config;
+    if (elements.algorithmSelect.querySelector(`option[value="${config.algorithm}"]`)) {
+        elements.algorithmSelect.value = config.algorithm;
+        elements.algorithmSelectSim.value = config.algorithm;
+    }
+    elements.timeQuantum.value = config.quantum;
+    elements.enableAging.checked = config.aging;
+    elements.enableAgingSim.checked = config.aging;
+    elements.agingThreshold.value = config.aging_threshold;
+    elements.agingBoostAmount.value = config.aging_boost;
+    timeResolution = config.time_resolution;
+    contextSwitchCost = config.context_switch;
+    scenarioDependencies = result.dependencies;
+    updateAlgorithmUI();
+
+    // The scenario's own ids are kept: they are what its dependencies and logs refer to
+    elements.processTableBody.innerHTML = '';
+    result.processes.forEach(p => appendProcessRow(p.id, p.name, p.arrival, p.burst, p.priority));
     updateProcessCount();
-    syncProcessesFromTable();
+    updateResultsTable();
+    addLogEntry(`Loaded scenario: ${result.processes.length} processes, ${config.algorithm}` +
+                (scenarioDependencies.length > 0 ? `, ${scenarioDependencies.length} dependencies` : '') +
+                (timeResolution > 1 ? `, ${timeResolution} ticks per time unit` : ''));
+}
+
+/**
+ * Scenario edges whose processes are still in the table, parent first
+ * (rows deleted or reordered since loading drop their edges)
+ */
+function activeDependencies() {
+    return scenarioDependencies.filter(d => {
+        const parent = processIndexById.get(d.parent);
+        const child = processIndexById.get(d.child);
+        return parent !== undefined && child !== undefined && parent < child;
+    });
 }
 
 // === Results Table (Live Updates) ===
@@ -329,14 +454,17 @@ function updateResultsTable() {
         row.id = `result-row-${p.id}`;
         row.className = 'state-not-arrived';
         row.innerHTML = `
-            <td>${p.name}</td>
-            <td>${p.arrival}</td>
-            <td>${p.burst}</td>
+            <td></td>
+            <td></td>
+            <td></td>
             <td class="waiting-cell">-</td>
             <td class="finish-cell">-</td>
             <td class="tat-cell">-</td>
             <td class="response-cell">-</td>
         `;
+        row.cells[0].textContent = p.name;
+        row.cells[1].textContent = p.arrival;
+        row.cells[2].textContent = p.burst;
         elements.resultsTableBody.appendChild(row);
     });
 }
@@ -428,39 +556,92 @@ function initializeScheduler() {
         return false;
     }
     
-    scheduler = new Module.Scheduler();
-    
-    const algorithm = elements.algorithmSelect.value;
-    const quantum = parseInt(elements.timeQuantum.value) || 2;
-    const agingEnabled = elements.enableAging.checked;
-    const agingThreshold = parseInt(elements.agingThreshold.value) || 5;
-    const agingBoostAmount = parseInt(elements.agingBoostAmount.value) || 1;
-    
-    scheduler.setAlgorithm(algorithm);
-    scheduler.setTimeQuantum(quantum);
-    scheduler.setAging(agingEnabled);
-    scheduler.setAgingThreshold(agingThreshold);
-    scheduler.setAgingBoostAmount(agingBoostAmount);
+    const config = readSchedulerConfig();
+    if (config.expression && Module.checkPriorityExpression) {
+        const error = Module.checkPriorityExpression(config.expression);
+        if (error) {
+            alert(`Score expression: ${error}`);
+            return false;
+        }
+    }
     
-    processes.forEach(p => {
-        scheduler.addProcess(p.id, p.name, p.arrival, p.burst, p.priority);
-    });
+    if (workerReady) {
+        startWorkerSession(config);
+    } else {
+        scheduler = new Module.Scheduler();
+        
+        // Before addProcess, which converts times at the current resolution
+        scheduler.setTimeResolution(config.timeResolution);
+        scheduler.setContextSwitchCost(config.contextSwitch);
+        scheduler.setAlgorithm(config.algorithm);
+        scheduler.setTimeQuantum(config.quantum);
+        scheduler.setAging(config.agingEnabled);
+        scheduler.setAgingThreshold(config.agingThreshold);
+        scheduler.setAgingBoostAmount(config.agingBoostAmount);
+        if (config.expression) {
+            // Builds without checkPriorityExpression (lean) report errors here
+            const error = scheduler.setPriorityExpression(config.expression);
+            if (error) {
+                alert(`Score expression: ${error}`);
+                scheduler.delete();
+                scheduler = null;
+                return false;
+            }
+        }
+        if (config.predictor) {
+            scheduler.setBurstPredictor(config.predictor, 0.5);
+        }
+        
+        processes.forEach(p => {
+            scheduler.addProcess(p.id, p.name, p.arrival, p.burst, p.priority);
+        });
+        config.dependencies.forEach(d => scheduler.addDependency(d.parent, d.child));
+        scheduler.setRecordTimeline(true);
+        if (scheduler.setLogCapacity) scheduler.setLogCapacity(LOG_RETAINED);
+    }
     
     // Reset UI state
     ganttData = [];
+    simTime = 0;
     elements.ganttChart.innerHTML = '';
     elements.ganttAxis.innerHTML = '';
-    elements.executionLog.innerHTML = '';
+    resetLogView();
     updateResultsTable();
     
     return true;
 }
 
+function readSchedulerConfig() {
+    const algorithm = elements.algorithmSelect.value;
+    return {
+        algorithm: algorithm,
+        expression: algorithm === 'Expr' || algorithm === 'ExprP' ? elements.priorityExpression.value : '',
+        predictor: (algorithm === 'SJF' || algorithm === 'SRTF') && elements.burstPredictor.value !== 'None'
+            ? elements.burstPredictor.value : '',
+        quantum: parseInt(elements.timeQuantum.value) || 2,
+        agingEnabled: elements.enableAging.checked,
+        agingThreshold: parseInt(elements.agingThreshold.value) || 5,
+        agingBoostAmount: parseInt(elements.agingBoostAmount.value) || 1,
+        timeResolution: timeResolution,
+        contextSwitch: contextSwitchCost,
+        dependencies: activeDependencies()
+    };
+}
+
+function isSessionActive() {
+    return scheduler !== null || workerSession;
+}
+
 function stepSimulation() {
-    if (!scheduler && !initializeScheduler()) {
+    if (!isSessionActive() && !initializeScheduler()) {
         return;
     }
     
+    if (workerSession) {
+        simWorker.postMessage({ type: 'step' });
+        return;  // The worker answers 'idle' once the frame is published
+    }
+    
     if (scheduler.isFinished()) {
         pausePlayback();
         return;
@@ -468,7 +649,7 @@ function stepSimulation() {
     
     // Execute one tick
     const tickLog = scheduler.tick();
-    const state = JSON.parse(scheduler.getStateJSON());
+    const state = readEngineState();
     
     // Update UI
     updateDashboard(state);
@@ -484,7 +665,7 @@ function stepSimulation() {
 }
 
 function startPlayback() {
-    if (!scheduler && !initializeScheduler()) {
+    if (!isSessionActive() && !initializeScheduler()) {
         return;
     }
     
@@ -493,8 +674,75 @@ function startPlayback() {
     elements.pauseBtn.disabled = false;
     elements.stepBtn.disabled = true;
     
-    const speed = 1050 - parseInt(elements.speedSlider.value);
-    playInterval = setInterval(stepSimulation, speed);
+    if (workerSession) {
+        simWorker.postMessage({ type: 'play', ticksPerSecond: workerTicksPerSecond() });
+        workerRunning = true;
+        scheduleDrain();
+        return;
+    }
+    
+    startMainThreadLoop();
+}
+
+/**
+ * Full speed runs as many ticks as fit in FAST_FRAME_BUDGET_MS per animation
+ * frame; other speeds run one tick per interval
+ */
+function startMainThreadLoop() {
+    const slider = elements.speedSlider;
+    if (slider.value === slider.max) {
+        fastFrameHandle = requestAnimationFrame(runFastFrame);
+    } else {
+        const speed = 1050 - parseInt(slider.value);
+        playInterval = setInterval(stepSimulation, speed);
+    }
+}
+
+function stopMainThreadLoop() {
+    if (playInterval) {
+        clearInterval(playInterval);
+        playInterval = null;
+    }
+    if (fastFrameHandle !== null) {
+        cancelAnimationFrame(fastFrameHandle);
+        fastFrameHandle = null;
+    }
+}
+
+function runFastFrame() {
+    fastFrameHandle = null;
+    const summary = scheduler.runFor(FAST_FRAME_BUDGET_MS, 0);
+    
+    // One timeline entry per tick; entry i is tick start + i, which ends at start + i + 1
+    const timeline = scheduler.getTimeline();
+    const start = scheduler.getTimelineStart();
+    for (let i = Math.max(0, timeline.length - summary.ticks); i < timeline.length; i++) {
+        const proc = processOf(timeline[i]);
+        recordGanttTick((start + i + 1) / timeResolution, proc ? proc.name : null);
+    }
+    
+    const state = readEngineState();
+    updateDashboard(state);
+    updateReadyQueue(state);
+    renderGanttChart();
+    updateResultsTableFromState(state);
+    if (summary.ticks > 0) addLogEntries(summary.log.split('\n'));
+    
+    if (summary.finished) {
+        pausePlayback();
+    } else {
+        fastFrameHandle = requestAnimationFrame(runFastFrame);
+    }
+}
+
+function onSpeedChange() {
+    if (!isPlaying) return;
+    if (workerSession) {
+        simWorker.postMessage({ type: 'speed', ticksPerSecond: workerTicksPerSecond() });
+    } else {
+        stopMainThreadLoop();
+        startMainThreadLoop();
+    }
 }
 
 function pausePlayback() {
@@ -503,9 +751,10 @@ function pausePlayback() {
     elements.pauseBtn.disabled = true;
     elements.stepBtn.disabled = false;
     
-    if (playInterval) {
-        clearInterval(playInterval);
-        playInterval = null;
+    stopMainThreadLoop();
+    
+    if (workerSession) {
+        simWorker.postMessage({ type: 'pause' });
     }
 }
 
@@ -517,6 +766,11 @@ function resetSimulation() {
         scheduler = null;
     }
     
+    if (workerSession) {
+        simWorker.postMessage({ type: 'reset' });
+        stopWorkerSession();
+    }
+    
     ganttData = [];
     
     elements.currentTime.textContent = '0';
@@ -525,7 +779,7 @@ function resetSimulation() {
     elements.readyQueue.innerHTML = '';
     elements.ganttChart.innerHTML = '';
     elements.ganttAxis.innerHTML = '';
-    elements.executionLog.innerHTML = '';
+    resetLogView();
     elements.avgWaitingTime.textContent = '-';
     elements.avgTurnaroundTime.textContent = '-';
     elements.avgResponseTime.textContent = '-';
@@ -535,6 +789,7 @@ function resetSimulation() {
 
 // === UI Update Functions ===
 function updateDashboard(state) {
+    simTime = state.time;
     elements.currentTime.textContent = state.time;
     
     if (state.cpu_process) {
@@ -575,8 +830,23 @@ function updateReadyQueue(state) {
 }
 
 function updateGanttChart(state) {
-    const currentTick = state.time - 1;
-    const processName = state.last_executed ? state.last_executed.name : null;
+    recordGanttTick(state.time, state.last_executed ? state.last_executed.name : null);
+    renderGanttChart();
+}
+
+/**
+ * Process with engine id 'id' (-1 or unknown: null)
+ */
+function processOf(id) {
+    const index = processIndexById.get(id);
+    return index === undefined ? null : processes[index];
+}
+
+/**
+ * Gantt blocks are kept in ticks; 'time' is the end of the tick in time units
+ */
+function recordGanttTick(time, processName) {
+    const currentTick = Math.round(time * timeResolution) - 1;
     
     // Check if we should merge with previous block
     if (ganttData.length > 0) {
@@ -585,7 +855,6 @@ function updateGanttChart(state) {
             // Extend the last block
             lastBlock.endTime = currentTick + 1;
             lastBlock.duration++;
-            renderGanttChart();
             return;
         }
     }
@@ -597,8 +866,10 @@ function updateGanttChart(state) {
         endTime: currentTick + 1,
         duration: 1
     });
-    
-    renderGanttChart();
+}
+
+function formatGanttTime(tick) {
+    return Number((tick / timeResolution).toPrecision(12));
 }
 
 function renderGanttChart() {
@@ -644,7 +915,7 @@ function renderGanttChart() {
             const startMarker = document.createElement('span');
             startMarker.className = 'gantt-axis-marker';
             startMarker.style.left = `${cumWidth}px`;
-            startMarker.textContent = block.startTime;
+            startMarker.textContent = formatGanttTime(block.startTime);
             elements.ganttAxis.appendChild(startMarker);
         }
         
@@ -654,7 +925,7 @@ function renderGanttChart() {
         const endMarker = document.createElement('span');
         endMarker.className = 'gantt-axis-marker';
         endMarker.style.left = `${cumWidth}px`;
-        endMarker.textContent = block.endTime;
+        endMarker.textContent = formatGanttTime(block.endTime);
         elements.ganttAxis.appendChild(endMarker);
     });
     
@@ -663,6 +934,25 @@ function renderGanttChart() {
 }
 
 function addLogEntry(log) {
+    addLogEntries([log]);
+}
+
+/**
+ * Append many log lines with a single layout/scroll update
+ * The live view keeps the newest LOG_PAGE lines; older ones are paged from the engine
+ */
+function addLogEntries(lines) {
+    if (logPageFrom !== null) return;  // Showing history: 'Live' reloads the tail
+    
+    const fragment = document.createDocumentFragment();
+    lines.slice(-LOG_PAGE).forEach(log => fragment.appendChild(createLogEntry(log)));
+    const log = elements.executionLog;
+    log.appendChild(fragment);
+    while (log.childElementCount > LOG_PAGE) log.firstElementChild.remove();
+    log.scrollTop = log.scrollHeight;
+}
+
+function createLogEntry(log) {
     const entry = document.createElement('div');
     entry.className = 'log-entry';
     
@@ -671,6 +961,349 @@ function addLogEntry(log) {
     }
     
     entry.textContent = log;
-    elements.executionLog.appendChild(entry);
-    elements.executionLog.scrollTop = elements.executionLog.scrollHeight;
+    return entry;
+}
+
+// === Log Paging ===
+// The engine keeps the last LOG_RETAINED tick logs (setLogCapacity); the page
+// shows one LOG_PAGE-line window of them at a time, fetched with getLog(from, count)
+function resetLogView() {
+    logPageFrom = null;
+    elements.executionLog.innerHTML = '';
+    updateLogPaging();
+}
+
+function canPageLog() {
+    return workerSession || (scheduler !== null && typeof scheduler.getLog === 'function');
+}
+
+function updateLogPaging() {
+    elements.logPaging.hidden = !canPageLog();
+    elements.logNewerBtn.disabled = logPageFrom === null;
+    elements.logLiveBtn.disabled = logPageFrom === null;
+}
+
+function showOlderLog() {
+    const span = LOG_PAGE / timeResolution;
+    const from = logPageFrom === null ? simTime - 2 * span : logPageFrom - span;
+    requestLogPage(Math.max(0, from), false);
+}
+
+function showNewerLog() {
+    if (logPageFrom === null) return;
+    const span = LOG_PAGE / timeResolution;
+    if (logPageFrom + 2 * span >= simTime) {
+        showLiveLog();
+    } else {
+        requestLogPage(logPageFrom + span, false);
+    }
+}
+
+function showLiveLog() {
+    requestLogPage(Math.max(0, simTime - LOG_PAGE / timeResolution), true);
+}
+
+function requestLogPage(from, live) {
+    if (workerSession) {
+        simWorker.postMessage({ type: 'log-page', from: from, count: LOG_PAGE, live: live });
+    } else if (canPageLog()) {
+        renderLogPage(JSON.parse(scheduler.getLog(from, LOG_PAGE)), from, live);
+    }
+}
+
+function renderLogPage(page, from, live) {
+    logPageFrom = live ? null : from;
+    const fragment = document.createDocumentFragment();
+    page.entries.forEach(entry => fragment.appendChild(createLogEntry(entry.text)));
+    const log = elements.executionLog;
+    log.innerHTML = '';
+    log.appendChild(fragment);
+    log.scrollTop = live ? log.scrollHeight : 0;
+    updateLogPaging();
+}
+
+// === Worker Mode ===
+// Requires cross-origin isolation for SharedArrayBuffer; otherwise the
+// simulation stays on the main thread with the setInterval loop above.
+function initializeWorker() {
+    if (!window.crossOriginIsolated || typeof SharedArrayBuffer === 'undefined' || !window.Worker) {
+        return;
+    }
+    
+    elements.compareBtn.hidden = false;
+    
+    try {
+        simWorker = new Worker('sim_worker.js');
+    } catch (e) {
+        console.warn('Simulation worker unavailable, running on main thread', e);
+        simWorker = null;
+        return;
+    }
+    
+    simWorker.onmessage = onWorkerMessage;
+    simWorker.onerror = () => {
+        console.warn('Simulation worker failed to load, running on main thread');
+        simWorker = null;
+        workerReady = false;
+        elements.compareBtn.disabled = false;
+    };
+}
+
+function onWorkerMessage(e) {
+    const msg = e.data;
+    if (msg.type === 'ready') {
+        workerReady = true;
+        console.log('Simulation worker ready');
+    } else if (msg.type === 'log') {
+        addLogEntries(msg.lines);
+    } else if (msg.type === 'finished') {
+        pausePlayback();
+    } else if (msg.type === 'sweep') {
+        onSweepResult(msg);
+    } else if (msg.type === 'log-page') {
+        if (workerSession) renderLogPage(msg.page, msg.from, msg.live);
+    } else if (msg.type === 'idle') {
+        // Everything up to here is already in the ring: one last drain, then stop
+        workerRunning = false;
+        scheduleDrain();
+    }
+}
+
+function workerTicksPerSecond() {
+    const slider = elements.speedSlider;
+    if (slider.value === slider.max) return 0;  // Full speed: unthrottled
+    return 1000 / (1050 - parseInt(slider.value));
+}
+
+function startWorkerSession(config) {
+    shared = SimShared.create(processes.length);
+    readSeq = 0;
+    workerSession = true;
+    
+    simWorker.postMessage({
+        type: 'init',
+        buffer: shared.buffer,
+        config: config,
+        processes: processes,
+        logCapacity: LOG_RETAINED
+    });
+}
+
+function stopWorkerSession() {
+    workerSession = false;
+    workerRunning = false;
+    shared = null;
+    if (frameHandle !== null) {
+        cancelAnimationFrame(frameHandle);
+        frameHandle = null;
+    }
+}
+
+/**
+ * Request a drain on the next animation frame unless one is already pending
+ */
+function scheduleDrain() {
+    if (frameHandle === null && shared) {
+        frameHandle = requestAnimationFrame(drainSharedState);
+    }
+}
+
+/**
+ * Per animation frame: consume every new ring frame into the Gantt data, then
+ * render the latest state once. Reschedules only while the worker is running,
+ * so a paused or finished session costs no frames
+ */
+function drainSharedState() {
+    frameHandle = null;
+    if (!shared) return;
+    if (workerRunning) scheduleDrain();
+    
+    const header = shared.header;
+    const ring = shared.ring;
+    const F = SimShared.FRAME_FIELDS;
+    const writeSeq = Atomics.load(header, SimShared.HDR_WRITE_SEQ);
+    if (readSeq === writeSeq) return;
+    
+    let latest = 0;
+    while (readSeq < writeSeq) {
+        latest = (readSeq % SimShared.RING_SIZE) * F;
+        const lastId = ring[latest + 1];
+        const proc = processOf(lastId);
+        recordGanttTick(ring[latest], proc ? proc.name : null);
+        readSeq++;
+    }
+    Atomics.store(header, SimShared.HDR_READ_SEQ, readSeq);
+    
+    const state = readSharedState(ring[latest], ring[latest + 2], ring[latest + 3]);
+    updateDashboard(state);
+    updateReadyQueue(state);
+    renderGanttChart();
+    updateResultsTableFromState(state);
+}
+
+/**
+ * Rebuild a getStateJSON()-shaped object from the shared process table
+ * Retries while the worker holds the seqlock
+ */
+function readSharedState(time, cpuId, cpuRemaining) {
+    const header = shared.header;
+    const F = SimShared.PROC_FIELDS;
+    let table;
+    
+    for (;;) {
+        const before = Atomics.load(header, SimShared.HDR_TABLE_VERSION);
+        if (before % 2 === 0) {
+            table = shared.table.slice();
+            if (Atomics.load(header, SimShared.HDR_TABLE_VERSION) === before) break;
+        }
+    }
+    
+    const cpuProc = processOf(cpuId);
+    const state = {
+        time: time,
+        cpu_process: cpuProc ? { id: cpuId, name: cpuProc.name, remaining: cpuRemaining } : null,
+        ready_queue: [],
+        finished: []
+    };
+    
+    processes.forEach((p, slot) => {
+        const base = slot * F;
+        if (table[base] === SimShared.STATE_READY) {
+            state.ready_queue.push({
+                id: p.id,
+                name: p.name,
+                remaining: table[base + 1],
+                priority: table[base + 2],
+                order: table[base + 6]
+            });
+        } else if (table[base] === SimShared.STATE_FINISHED) {
+            state.finished.push({
+                id: p.id,
+                name: p.name,
+                waiting_time: table[base + 3],
+                turnaround_time: table[base + 4],
+                response_time: table[base + 5]
+            });
+        }
+    });
+    state.ready_queue.sort((a, b) => a.order - b.order);
+    
+    return state;
+}
+
+/**
+ * Build a getStateJSON()-shaped object from the engine's typed-array views
+ * (no JSON round trip; the lean build has no getStateJSON at all)
+ */
+function readEngineState() {
+    const frame = scheduler.getStateFrame();
+    const t = scheduler.getProcessTable();
+    const timeline = scheduler.getTimeline();
+    const lastId = timeline.length > 0 ? timeline[timeline.length - 1] : -1;
+    const lastProc = processOf(lastId);
+    const cpuProc = processOf(frame.cpuId);
+    const state = {
+        time: frame.time,
+        cpu_process: cpuProc ? { id: frame.cpuId, name: cpuProc.name, remaining: frame.cpuRemaining } : null,
+        last_executed: lastProc ? { id: lastId, name: lastProc.name } : null,
+        ready_queue: [],
+        finished: []
+    };
+    
+    processes.forEach((p, slot) => {
+        if (t.state[slot] === SimShared.STATE_READY) {
+            state.ready_queue.push({
+                id: p.id,
+                name: p.name,
+                remaining: t.remaining[slot],
+                priority: t.priority[slot],
+                order: t.readyOrder[slot]
+            });
+        } else if (t.state[slot] === SimShared.STATE_FINISHED) {
+            state.finished.push({
+                id: p.id,
+                name: p.name,
+                waiting_time: t.waiting[slot],
+                turnaround_time: t.turnaround[slot],
+                response_time: t.response[slot]
+            });
+        }
+    });
+    state.ready_queue.sort((a, b) => a.order - b.order);
+    
+    return state;
+}
+
+// === Parallel Comparison (scheduler_wasm_mt) ===
+// The sweep runs in the simulation worker: joining the pthread pool would
+// otherwise block the page
+let sweepRequestId = 0;
+
+/**
+ * Run every algorithm on the current process table across the pthread pool
+ * and summarize the results in the execution log
+ */
+function compareAlgorithms() {
+    syncProcessesFromTable();
+    if (processes.length === 0) {
+        alert('Please add at least one process.');
+        return;
+    }
+    if (!simWorker || !workerReady) {
+        addLogEntry('Comparison unavailable: the simulation worker is not running.');
+        return;
+    }
+    
+    elements.compareBtn.disabled = true;
+    simWorker.postMessage({ type: 'sweep', id: ++sweepRequestId, request: buildSweepRequest() });
+}
+
+function buildSweepRequest() {
+    const config = readSchedulerConfig();
+    const algorithms = ['FCFS', 'SJF', 'SRTF', 'RR', 'Priority', 'PriorityNP', 'HRRN', 'HRRNP'];
+    if (config.expression) algorithms.push(config.algorithm);
+    const jobs = algorithms.map(algorithm => ({
+        algorithm: algorithm,
+        quantum: config.quantum,
+        aging: config.agingEnabled,
+        aging_threshold: config.agingThreshold,
+        aging_boost: config.agingBoostAmount,
+        expression: algorithm === config.algorithm ? config.expression : ''
+    }));
+    // Non-clairvoyant SJF/SRTF alongside the exact ones
+    if (config.predictor) {
+        ['SJF', 'SRTF'].forEach(algorithm => jobs.push({
+            algorithm: algorithm,
+            predictor: config.predictor
+        }));
+    }
+    return { processes: processes, dependencies: config.dependencies, jobs: jobs };
+}
+
+function onSweepResult(msg) {
+    if (msg.id !== sweepRequestId) return;  // Superseded request
+    elements.compareBtn.disabled = false;
+    
+    if (msg.error) {
+        console.error('Parallel comparison unavailable', msg.error);
+        addLogEntry('Comparison unavailable: scheduler_wasm_mt could not be loaded.');
+        return;
+    }
+    const response = msg.response;
+    if (response.error) {
+        addLogEntry(`Comparison failed: ${response.error}`);
+        return;
+    }
+    addLogEntry(`Comparison on ${msg.workers} threads (avg waiting / turnaround / response):`);
+    response.results.forEach((r, i) => {
+        const marker = response.best.avg_waiting_time === i ? ' ★' : '';
+        let label = r.expression ? `${r.algorithm} [${r.expression}]` : r.algorithm;
+        let regret = '';
+        if (r.predictor) {
+            label = `${r.algorithm} (${r.predictor})`;
+            regret = `, regret ${r.regret.toFixed(2)}, prediction error ${r.prediction_error.toFixed(2)}`;
+        }
+        addLogEntry(`  ${label}: ${r.avg_waiting_time.toFixed(2)} / ` +
+            `${r.avg_turnaround_time.toFixed(2)} / ${r.avg_response_time.toFixed(2)}${marker}${regret}`);
+    });
 }
@@ -0,0 +1,54 @@
+/**
+ * CPU Scheduler Simulator - Shared State Layout
+ * SharedArrayBuffer layout used by the page (script.js) and the simulation worker
+ *
+ * [header: Int32 x HDR_FIELDS][ring: Float64 x RING_SIZE*FRAME_FIELDS][table: Float64 x n*PROC_FIELDS]
+ */
+
+const SimShared = {
+    // Header slots (Int32, accessed with Atomics)
+    HDR_WRITE_SEQ: 0,       // Frames written by the worker
+    HDR_READ_SEQ: 1,        // Frames consumed by the page (worker backpressure)
+    HDR_PROC_COUNT: 2,
+    HDR_FINISHED: 3,        // 1 once the simulation has completed
+    HDR_TABLE_VERSION: 4,   // Seqlock: odd while the worker rewrites the table
+    HDR_FIELDS: 8,
+
+    // Per-tick ring: time, lastExecutedId, cpuId, cpuRemaining
+    RING_SIZE: 4096,
+    FRAME_FIELDS: 4,
+
+    // Per-process table (slot = addProcess order, copied from Scheduler.getProcessTable())
+    // state, remaining, priority, waiting, turnaround, response, readyOrder
+    // Process ids are whatever the page's table holds (scenario ids are kept), so
+    // the page maps ids in ring frames (lastExecutedId, cpuId) to slots by id
+    PROC_FIELDS: 7,
+
+    STATE_NOT_ARRIVED: 0,
+    STATE_READY: 1,
+    STATE_RUNNING: 2,
+    STATE_FINISHED: 3,
+    STATE_BLOCKED: 4,
+
+    byteLength(processCount) {
+        return this.HDR_FIELDS * 4
+            + this.RING_SIZE * this.FRAME_FIELDS * 8
+            + processCount * this.PROC_FIELDS * 8;
+    },
+
+    create(processCount) {
+        const buffer = new SharedArrayBuffer(this.byteLength(processCount));
+        const views = this.attach(buffer);
+        views.header[this.HDR_PROC_COUNT] = processCount;
+        return views;
+    },
+
+    attach(buffer) {
+        const header = new Int32Array(buffer, 0, this.HDR_FIELDS);
+        const ringOffset = this.HDR_FIELDS * 4;
+        const ring = new Float64Array(buffer, ringOffset, this.RING_SIZE * this.FRAME_FIELDS);
+        const tableOffset = ringOffset + ring.byteLength;
+        const table = new Float64Array(buffer, tableOffset, (buffer.byteLength - tableOffset) / 8);
+        return { buffer, header, ring, table };
+    }
+};
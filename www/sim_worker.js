@@ -0,0 +1,233 @@
+/**
+ * CPU Scheduler Simulator - Simulation Worker
+ * Hosts the Scheduler off the main thread and publishes compact state into a
+ * SharedArrayBuffer (see sim_shared.js) that the page reads every animation frame
+ * while the worker is running; 'idle' tells the page to drain once more and stop
+ */
+
+var Module = {
+    onRuntimeInitialized: function() {
+        postMessage({ type: 'ready' });
+    }
+};
+
+importScripts('sim_shared.js', 'scheduler_wasm_worker.js');
+
+const CHUNK_BUDGET_MS = 8;      // Max time spent ticking before yielding to messages
+
+let scheduler = null;
+let shared = null;
+let running = false;
+let ticksPerSecond = 0;         // 0 = run as fast as possible
+let tickCredit = 0;             // Fractional ticks owed when throttled
+let lastChunkTime = 0;
+let logBatch = [];
+
+onmessage = function(e) {
+    const msg = e.data;
+    switch (msg.type) {
+        case 'init':
+            initialize(msg);
+            break;
+        case 'play':
+            ticksPerSecond = msg.ticksPerSecond;
+            if (!running) {
+                running = true;
+                tickCredit = 0;
+                lastChunkTime = performance.now();
+                runChunk();
+            }
+            break;
+        case 'speed':
+            ticksPerSecond = msg.ticksPerSecond;
+            break;
+        case 'pause':
+            running = false;
+            postMessage({ type: 'idle' });
+            break;
+        case 'step':
+            if (scheduler && !scheduler.isFinished() && ringHasRoom()) {
+                runTick();
+                publish();
+            }
+            postMessage({ type: 'idle' });
+            break;
+        case 'sweep':
+            runSweep(msg);
+            break;
+        case 'log-page':
+            if (scheduler) {
+                const page = JSON.parse(scheduler.getLog(msg.from, msg.count));
+                postMessage({ type: 'log-page', page: page, from: msg.from, live: msg.live });
+            }
+            break;
+        case 'reset':
+            running = false;
+            if (scheduler) {
+                scheduler.delete();
+                scheduler = null;
+            }
+            shared = null;
+            break;
+    }
+};
+
+// === Setup ===
+function initialize(msg) {
+    running = false;
+    if (scheduler) scheduler.delete();
+
+    shared = SimShared.attach(msg.buffer);
+    scheduler = new Module.Scheduler();
+
+    const config = msg.config;
+    scheduler.setTimeResolution(config.timeResolution);
+    scheduler.setContextSwitchCost(config.contextSwitch);
+    scheduler.setAlgorithm(config.algorithm);
+    scheduler.setTimeQuantum(config.quantum);
+    scheduler.setAging(config.agingEnabled);
+    scheduler.setAgingThreshold(config.agingThreshold);
+    scheduler.setAgingBoostAmount(config.agingBoostAmount);
+    if (config.expression && scheduler.setPriorityExpression) {
+        scheduler.setPriorityExpression(config.expression);
+    }
+    if (config.predictor && scheduler.setBurstPredictor) {
+        scheduler.setBurstPredictor(config.predictor, 0.5);
+    }
+
+    msg.processes.forEach(p => {
+        scheduler.addProcess(p.id, p.name, p.arrival, p.burst, p.priority);
+    });
+    config.dependencies.forEach(d => scheduler.addDependency(d.parent, d.child));
+    scheduler.setLogCapacity(msg.logCapacity);
+
+    logBatch = [];
+    publish();
+    postMessage({ type: 'idle' });
+}
+
+// === Parallel Comparison (scheduler_wasm_mt) ===
+// runSweep() joins its pthread pool, which blocks the calling thread, so it runs
+// here rather than on the page. The module is loaded on the first request.
+let sweepModule = null;
+
+function loadSweepModule() {
+    if (!sweepModule) {
+        importScripts('scheduler_wasm_mt.js');
+        // Pthreads must load the module script, not this worker's script
+        sweepModule = createSchedulerMT({ mainScriptUrlOrBlob: 'scheduler_wasm_mt.js' });
+    }
+    return sweepModule;
+}
+
+function runSweep(msg) {
+    let module;
+    try {
+        module = loadSweepModule();
+    } catch (e) {
+        postMessage({ type: 'sweep', id: msg.id, error: String(e) });
+        return;
+    }
+    module.then(m => {
+        const response = JSON.parse(m.runSweep(JSON.stringify(msg.request)));
+        postMessage({ type: 'sweep', id: msg.id, response: response, workers: m.getWorkerCount() });
+    }, e => {
+        sweepModule = null;
+        postMessage({ type: 'sweep', id: msg.id, error: String(e) });
+    });
+}
+
+// === Execution ===
+function ringHasRoom() {
+    const written = Atomics.load(shared.header, SimShared.HDR_WRITE_SEQ);
+    const read = Atomics.load(shared.header, SimShared.HDR_READ_SEQ);
+    return written - read < SimShared.RING_SIZE;
+}
+
+function runTick() {
+    logBatch.push(scheduler.tick());
+
+    const frame = scheduler.getStateFrame();
+    const seq = Atomics.load(shared.header, SimShared.HDR_WRITE_SEQ);
+    const base = (seq % SimShared.RING_SIZE) * SimShared.FRAME_FIELDS;
+    shared.ring[base] = frame.time;
+    shared.ring[base + 1] = frame.lastExecutedId;
+    shared.ring[base + 2] = frame.cpuId;
+    shared.ring[base + 3] = frame.cpuRemaining;
+
+    // Publish the frame only after its fields are written
+    Atomics.store(shared.header, SimShared.HDR_WRITE_SEQ, seq + 1);
+}
+
+/**
+ * Run ticks for up to CHUNK_BUDGET_MS, then yield so messages (pause/speed) are seen
+ * Stops early when the page has not drained the ring (backpressure, no frames lost)
+ */
+function runChunk() {
+    if (!running || !scheduler) return;
+
+    const start = performance.now();
+    let allowed = Infinity;
+    if (ticksPerSecond > 0) {
+        tickCredit += (start - lastChunkTime) * ticksPerSecond / 1000;
+        allowed = Math.floor(tickCredit);
+        tickCredit -= allowed;
+    }
+    lastChunkTime = start;
+
+    let ran = 0;
+    while (ran < allowed && !scheduler.isFinished() && ringHasRoom()) {
+        runTick();
+        ran++;
+        if ((ran & 63) === 0 && performance.now() - start > CHUNK_BUDGET_MS) break;
+    }
+
+    if (ran > 0) publish();
+
+    if (scheduler.isFinished()) {
+        running = false;
+        postMessage({ type: 'idle' });
+        return;
+    }
+    setTimeout(runChunk, ticksPerSecond > 0 ? 4 : 0);
+}
+
+// === Publishing ===
+/**
+ * Copy the engine's process table views into the shared table under a seqlock
+ * and flush batched log lines
+ */
+function publish() {
+    const t = scheduler.getProcessTable();
+    const header = shared.header;
+    const table = shared.table;
+    const F = SimShared.PROC_FIELDS;
+    const count = Math.min(header[SimShared.HDR_PROC_COUNT], t.ids.length);
+    
+    Atomics.add(header, SimShared.HDR_TABLE_VERSION, 1);  // Odd: write in progress
+    
+    for (let slot = 0; slot < count; slot++) {
+        const base = slot * F;
+        table[base] = t.state[slot];
+        table[base + 1] = t.remaining[slot];
+        table[base + 2] = t.priority[slot];
+        table[base + 3] = t.waiting[slot];
+        table[base + 4] = t.turnaround[slot];
+        table[base + 5] = t.response[slot];
+        table[base + 6] = t.readyOrder[slot];
+    }
+    
+    Atomics.add(header, SimShared.HDR_TABLE_VERSION, 1);  // Even: table consistent
+    
+    if (scheduler.isFinished()) {
+        Atomics.store(header, SimShared.HDR_FINISHED, 1);
+    }
+
+    if (logBatch.length > 0) {
+        postMessage({ type: 'log', lines: logBatch });
+        logBatch = [];
+    }
+    if (scheduler.isFinished()) {
+        postMessage({ type: 'finished' });
+    }
+}